@@ -0,0 +1,41 @@
+#include "command_buffer.h"
+#include "game.h"
+
+#include <stdlib.h>
+
+result_code command_buffer_init(command_buffer *buffer, const size_t capacity) {
+    VALIDATE_PTR_RET(buffer, result_error_null_ptr);
+
+    *buffer = (command_buffer){0};
+    buffer->spawns = malloc(sizeof(game_object) * capacity);
+    if (buffer->spawns == nullptr) {
+        return result_error_out_of_memory;
+    }
+    buffer->capacity = capacity;
+    return result_ok;
+}
+
+void command_buffer_free(command_buffer *buffer) {
+    VALIDATE_PTR(buffer);
+
+    free(buffer->spawns);
+    *buffer = (command_buffer){0};
+}
+
+result_code command_buffer_push_spawn(command_buffer *buffer, const game_object *obj) {
+    VALIDATE_PTR_RET(buffer, result_error_null_ptr);
+    VALIDATE_PTR_RET(obj, result_error_null_ptr);
+
+    if (buffer->count == buffer->capacity) {
+        return result_error_out_of_bounds;
+    }
+
+    buffer->spawns[buffer->count++] = *obj;
+    return result_ok;
+}
+
+void command_buffer_clear(command_buffer *buffer) {
+    VALIDATE_PTR(buffer);
+
+    buffer->count = 0;
+}
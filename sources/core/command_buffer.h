@@ -0,0 +1,21 @@
+#ifndef PROJEKT_COMMAND_BUFFER_H
+#define PROJEKT_COMMAND_BUFFER_H
+
+#include <stddef.h>
+
+#include "game_object.h"
+
+// Spawns requested while the stores are being updated. The storage is
+// allocated once up front and reset every tick, so queueing never reallocates.
+typedef struct {
+    game_object *spawns;
+    size_t count;
+    size_t capacity;
+} command_buffer;
+
+result_code command_buffer_init(command_buffer *buffer, size_t capacity);
+void command_buffer_free(command_buffer *buffer);
+result_code command_buffer_push_spawn(command_buffer *buffer, const game_object *obj);
+void command_buffer_clear(command_buffer *buffer);
+
+#endif //PROJEKT_COMMAND_BUFFER_H
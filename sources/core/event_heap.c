@@ -0,0 +1,102 @@
+#include "event_heap.h"
+#include "game.h"
+
+#include <stdlib.h>
+
+result_code event_heap_init(event_heap *heap, const size_t capacity) {
+    VALIDATE_PTR_RET(heap, result_error_null_ptr);
+
+    *heap = (event_heap){0};
+    heap->events = malloc(sizeof(scheduled_event) * capacity);
+    if (heap->events == nullptr) {
+        return result_error_out_of_memory;
+    }
+    heap->capacity = capacity;
+    return result_ok;
+}
+
+void event_heap_free(event_heap *heap) {
+    VALIDATE_PTR(heap);
+
+    free(heap->events);
+    *heap = (event_heap){0};
+}
+
+static void swap_events(scheduled_event *a, scheduled_event *b) {
+    const scheduled_event tmp = *a;
+    *a = *b;
+    *b = tmp;
+}
+
+result_code event_heap_push(event_heap *heap, const uint64_t due_tick, const int id) {
+    VALIDATE_PTR_RET(heap, result_error_null_ptr);
+
+    if (heap->count == heap->capacity) {
+        const size_t new_capacity = heap->capacity == 0 ? STARTING_COUNT_OF_GAME_OBJECTS : heap->capacity * 2;
+        scheduled_event *events = realloc(heap->events, sizeof(scheduled_event) * new_capacity);
+        if (events == nullptr) {
+            return result_error_out_of_memory;
+        }
+        heap->events = events;
+        heap->capacity = new_capacity;
+    }
+
+    size_t child = heap->count++;
+    heap->events[child] = (scheduled_event){ .due_tick = due_tick, .id = id };
+
+    while (child > 0) {
+        const size_t parent = (child - 1) / 2;
+        if (heap->events[parent].due_tick <= heap->events[child].due_tick) {
+            break;
+        }
+        swap_events(&heap->events[parent], &heap->events[child]);
+        child = parent;
+    }
+
+    return result_ok;
+}
+
+bool event_heap_has_due(const event_heap *heap, const uint64_t now) {
+    VALIDATE_PTR_RET(heap, false);
+
+    return heap->count > 0 && heap->events[0].due_tick <= now;
+}
+
+bool event_heap_pop_due(event_heap *heap, const uint64_t now, scheduled_event *out) {
+    VALIDATE_PTR_RET(heap, false);
+    VALIDATE_PTR_RET(out, false);
+
+    if (heap->count == 0 || heap->events[0].due_tick > now) {
+        return false;
+    }
+
+    *out = heap->events[0];
+    heap->events[0] = heap->events[--heap->count];
+
+    size_t parent = 0;
+    for (;;) {
+        const size_t left = parent * 2 + 1;
+        const size_t right = left + 1;
+        size_t smallest = parent;
+
+        if (left < heap->count && heap->events[left].due_tick < heap->events[smallest].due_tick) {
+            smallest = left;
+        }
+        if (right < heap->count && heap->events[right].due_tick < heap->events[smallest].due_tick) {
+            smallest = right;
+        }
+        if (smallest == parent) {
+            break;
+        }
+        swap_events(&heap->events[parent], &heap->events[smallest]);
+        parent = smallest;
+    }
+
+    return true;
+}
+
+void event_heap_clear(event_heap *heap) {
+    VALIDATE_PTR(heap);
+
+    heap->count = 0;
+}
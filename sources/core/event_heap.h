@@ -0,0 +1,28 @@
+#ifndef PROJEKT_EVENT_HEAP_H
+#define PROJEKT_EVENT_HEAP_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "game_object.h"
+
+typedef struct {
+    uint64_t due_tick;
+    int id;
+} scheduled_event;
+
+// Binary min-heap of events ordered by the simulation tick they fall due on
+typedef struct {
+    scheduled_event *events;
+    size_t count;
+    size_t capacity;
+} event_heap;
+
+result_code event_heap_init(event_heap *heap, size_t capacity);
+void event_heap_free(event_heap *heap);
+result_code event_heap_push(event_heap *heap, uint64_t due_tick, int id);
+bool event_heap_has_due(const event_heap *heap, uint64_t now);
+bool event_heap_pop_due(event_heap *heap, uint64_t now, scheduled_event *out);
+void event_heap_clear(event_heap *heap);
+
+#endif //PROJEKT_EVENT_HEAP_H
@@ -0,0 +1,56 @@
+#include "fx_pool.h"
+#include "game.h"
+
+#include <stdlib.h>
+
+result_code fx_pool_init(fx_pool *pool, const size_t capacity) {
+    VALIDATE_PTR_RET(pool, result_error_null_ptr);
+
+    *pool = (fx_pool){0};
+    pool->effects = malloc(sizeof(death_fx) * capacity);
+    if (pool->effects == nullptr) {
+        return result_error_out_of_memory;
+    }
+    pool->capacity = capacity;
+    return result_ok;
+}
+
+void fx_pool_free(fx_pool *pool) {
+    VALIDATE_PTR(pool);
+
+    free(pool->effects);
+    *pool = (fx_pool){0};
+}
+
+result_code fx_pool_push(fx_pool *pool, const death_fx *fx) {
+    VALIDATE_PTR_RET(pool, result_error_null_ptr);
+    VALIDATE_PTR_RET(fx, result_error_null_ptr);
+
+    if (pool->count == pool->capacity) {
+        const size_t new_capacity = pool->capacity == 0 ? STARTING_COUNT_OF_GAME_OBJECTS : pool->capacity * 2;
+        death_fx *effects = realloc(pool->effects, sizeof(death_fx) * new_capacity);
+        if (effects == nullptr) {
+            return result_error_out_of_memory;
+        }
+        pool->effects = effects;
+        pool->capacity = new_capacity;
+    }
+
+    pool->effects[pool->count++] = *fx;
+    return result_ok;
+}
+
+void fx_pool_remove(fx_pool *pool, const size_t index) {
+    VALIDATE_PTR(pool);
+
+    if (index >= pool->count) {
+        return;
+    }
+    pool->effects[index] = pool->effects[--pool->count];
+}
+
+void fx_pool_clear(fx_pool *pool) {
+    VALIDATE_PTR(pool);
+
+    pool->count = 0;
+}
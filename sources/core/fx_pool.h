@@ -0,0 +1,29 @@
+#ifndef PROJEKT_FX_POOL_H
+#define PROJEKT_FX_POOL_H
+
+#include <stddef.h>
+
+#include "game_object.h"
+
+// What is left of an enemy once it has been killed: just enough to finish
+// playing its death animation. Finished effects are swapped out of the pool.
+typedef struct {
+    vector2 position;
+    enemy_type anim;
+    int frame;
+    float frame_timer;
+} death_fx;
+
+typedef struct {
+    death_fx *effects;
+    size_t count;
+    size_t capacity;
+} fx_pool;
+
+result_code fx_pool_init(fx_pool *pool, size_t capacity);
+void fx_pool_free(fx_pool *pool);
+result_code fx_pool_push(fx_pool *pool, const death_fx *fx);
+void fx_pool_remove(fx_pool *pool, size_t index);
+void fx_pool_clear(fx_pool *pool);
+
+#endif //PROJEKT_FX_POOL_H
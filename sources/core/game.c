@@ -4,43 +4,10 @@
 #include "game.h"
 #include "tower.h"
 #include "enemy.h"
-#include "renderer.h"
 #include "projectile.h"
 
 #include <stdio.h>
-#include <stdlib.h>
-
-void handle_playing_input(game *g) {
-    if (g == nullptr) return;
-
-    const grid_coord grid_pos = screen_to_grid(get_mouse_position(), &g->tilemap);
-
-    const game_object* hovered_tower = find_tower_at_grid(g, grid_pos);
-    const int spot_index = find_tower_spot_at_grid(g, grid_pos);
-
-    if (hovered_tower != nullptr || spot_index >= 0) {
-        use_pointer_cursor();
-    } else {
-        use_normal_cursor();
-    }
-
-    if (is_mouse_button_pressed(mouse_button_left)) {
-        const upgrade_result result = upgrade_clicked_tower(g, grid_pos);
-        switch (result) {
-            case upgrade_success:
-            case upgrade_insufficient_funds:
-            case upgrade_max_level:
-                break;
-            case upgrade_not_found:
-                if (spot_index >= 0) {
-                    try_build_tower(g, spot_index);
-                }
-                break;
-            default:
-                break;
-        }
-    }
-}
+#include <math.h>
 
 wave_config get_wave_config(const int wave_number) {
     const wave_config waves[] = {
@@ -68,24 +35,51 @@ wave_config get_wave_config(const int wave_number) {
     return waves[wave_number];
 }
 
+wave_config get_horde_wave_config(const int wave_number) {
+    const int step = HORDE_SPAWN_BATCH_STEP * (wave_number + 1);
+    const int batch = step < HORDE_MAX_SPAWN_BATCH ? step : HORDE_MAX_SPAWN_BATCH;
+
+    return (wave_config){
+        .enemy_count = batch * HORDE_SPAWN_SECONDS * SIM_TICK_RATE,
+        .spawn_interval = SIM_TICK_DURATION,
+        .spawn_batch = batch,
+        .flying_chance = 50,
+        .allow_bottom_path = true
+    };
+}
+
+wave_config get_game_wave_config(const game *g, const int wave_number) {
+    if (g != nullptr && g->endless) {
+        return get_horde_wave_config(wave_number);
+    }
+    return get_wave_config(wave_number);
+}
+
+void enable_endless_mode(game *g) {
+    VALIDATE_PTR(g);
+
+    g->endless = true;
+    g->object_limit = ENDLESS_MAX_GAME_OBJECTS;
+}
+
 void spawn_enemy(game *g) {
     if (g == nullptr) return;
 
-    const wave_config wave = get_wave_config(g->current_wave);
+    const wave_config wave = get_game_wave_config(g, g->current_wave);
 
     int chosen_path;
     if (wave.allow_bottom_path) {
-        chosen_path = get_random_value(0, 1);
+        chosen_path = game_random_value(g, 0, 1);
     } else {
         chosen_path = 0;
     }
 
-    const enemy_type etype = get_random_value(1, 100) <= wave.flying_chance ? enemy_type_flying : enemy_type_mushroom;
+    const enemy_type etype = game_random_value(g, 1, 100) <= wave.flying_chance ? enemy_type_flying : enemy_type_mushroom;
     const enemy_stats stats = get_enemy_stats(etype);
 
     const vector2 start_pos = get_path_start_position(chosen_path);
 
-    const result_code res = add_game_object(g, (game_object) {
+    const result_code res = queue_spawn(g, (game_object) {
         .type = enemy,
         .position = start_pos,
         .is_active = true,
@@ -93,18 +87,20 @@ void spawn_enemy(game *g) {
             .health = stats.health,
             .max_health = stats.health,
             .speed = stats.speed,
+            .distance = 0.0f,
             .waypoint_index = 0,
             .path_id = chosen_path,
             .gold_reward = stats.gold_reward,
             .type = etype,
             .anim_state = enemy_anim_run,
             .current_frame = 0,
-            .frame_timer = 0.0f
+            .frame_timer = 0.0f,
+            .hit_tick = ENEMY_NO_HIT_TICK
         }
     });
 
     if (res != result_ok) {
-        fprintf(stderr, "ERROR: Failed to spawn enemy: code %u\n", (unsigned)res);
+        fprintf(stderr, "ERROR: Failed to queue enemy spawn: code %u\n", (unsigned)res);
         return;
     }
 
@@ -112,6 +108,19 @@ void spawn_enemy(game *g) {
     g->enemies_alive++;
 }
 
+// Per-game generator so a simulation replays identically from the same seed,
+// independent of other callers of get_random_value.
+int game_random_value(game *g, const int min, const int max) {
+    VALIDATE_PTR_RET(g, min);
+
+    if (min > max) {
+        return game_random_value(g, max, min);
+    }
+
+    g->rng_state = g->rng_state * 1103515245U + 12345U;
+    return min + (int)((g->rng_state >> 16) % (unsigned int)(max - min + 1));
+}
+
 void start_next_wave(game *g) {
     if (g == nullptr) return;
 
@@ -119,10 +128,17 @@ void start_next_wave(game *g) {
     g->enemies_spawned_in_wave = 0;
     g->enemies_alive = 0;
 
-    const wave_config wave = get_wave_config(g->current_wave);
+    const wave_config wave = get_game_wave_config(g, g->current_wave);
     g->enemy_spawn_timer = wave.spawn_interval;
 }
 
+bool is_wave_finished(const game *g) {
+    VALIDATE_PTR_RET(g, false);
+
+    const wave_config wave = get_game_wave_config(g, g->current_wave);
+    return g->enemies_spawned_in_wave >= wave.enemy_count && g->enemies_alive == 0;
+}
+
 void reset_game(game *g) {
     if (g == nullptr) return;
 
@@ -134,336 +150,376 @@ void reset_game(game *g) {
     g->enemies_alive = 0;
     g->wave_break_timer = 0.0f;
 
-    for (size_t i = 0; i < g->object_count; i++) {
-        if (g->game_objects[i].type == enemy || g->game_objects[i].type == projectile) {
-            g->game_objects[i].is_active = false;
-        }
+    for (size_t i = 0; i < g->enemies.count; i++) {
+        g->enemies.is_active[i] = false;
     }
-    remove_inactive_objects(g);
+    for (size_t i = 0; i < g->projectiles.count; i++) {
+        g->projectiles.is_active[i] = false;
+    }
+    command_buffer_clear(&g->commands);
+    impact_schedule_clear(&g->impacts);
+    target_index_clear(&g->targets);
+    fx_pool_clear(&g->death_effects);
+    event_heap_clear(&g->enemy_exits);
+    enemy_store_compact(&g->enemies, &g->handles);
+    projectile_store_compact(&g->projectiles, &g->handles);
+}
+
+void free_game_state(game *g) {
+    VALIDATE_PTR(g);
+
+    enemy_store_free(&g->enemies);
+    tower_store_free(&g->towers);
+    projectile_store_free(&g->projectiles);
+    handle_table_free(&g->handles);
+    spatial_grid_free(&g->enemy_grid);
+    command_buffer_free(&g->commands);
+    tower_schedule_free(&g->tower_schedule);
+    impact_schedule_free(&g->impacts);
+    target_index_free(&g->targets);
+    fx_pool_free(&g->death_effects);
+    event_heap_free(&g->enemy_exits);
 }
 
-game init_game() {
-    game g;
-    g.tilemap = init_tilemap();
-    g.game_objects =  malloc(sizeof(game_object) * STARTING_COUNT_OF_GAME_OBJECTS);
-    if (g.game_objects == nullptr) {
+result_code init_game_state(game *g, const unsigned int seed) {
+    VALIDATE_PTR_RET(g, result_error_null_ptr);
+
+    *g = (game){0};
+    init_enemy_paths();
+
+    if (enemy_store_init(&g->enemies, STARTING_COUNT_OF_GAME_OBJECTS, ENDLESS_MAX_GAME_OBJECTS) != result_ok ||
+        tower_store_init(&g->towers, STARTING_COUNT_OF_GAME_OBJECTS, MAX_GAME_OBJECTS) != result_ok ||
+        projectile_store_init(&g->projectiles, STARTING_COUNT_OF_GAME_OBJECTS, ENDLESS_MAX_GAME_OBJECTS) != result_ok ||
+        handle_table_init(&g->handles, HANDLE_MAX_SLOTS) != result_ok ||
+        spatial_grid_init(&g->enemy_grid, MAP_WIDTH, MAP_HEIGHT) != result_ok ||
+        command_buffer_init(&g->commands, COMMAND_BUFFER_CAPACITY) != result_ok ||
+        tower_schedule_init(&g->tower_schedule, STARTING_COUNT_OF_GAME_OBJECTS) != result_ok ||
+        impact_schedule_init(&g->impacts, STARTING_COUNT_OF_GAME_OBJECTS) != result_ok ||
+        target_index_init(&g->targets, HANDLE_MAX_SLOTS) != result_ok ||
+        fx_pool_init(&g->death_effects, STARTING_COUNT_OF_GAME_OBJECTS) != result_ok ||
+        event_heap_init(&g->enemy_exits, STARTING_COUNT_OF_GAME_OBJECTS) != result_ok) {
         fprintf(stderr, "ERROR: Failed to allocate memory for game objects\n");
-        unload_tilemap(&g.tilemap);
-        exit(1);
-    }
-    g.object_capacity = STARTING_COUNT_OF_GAME_OBJECTS;
-    g.object_count = 0;
-    g.player_money = STARTING_AMOUNT_OF_MONEY;
-    g.player_lives = STARTING_AMOUNT_OF_LIVES;
-    g.enemy_spawn_timer = 0.0f;
-    g.next_id = 0;
-    g.state = game_state_start;
-    g.enemies_defeated = 0;
-
-    g.current_wave = -1;
-    g.enemies_spawned_in_wave = 0;
-    g.enemies_alive = 0;
-    g.wave_break_timer = 0.0f;
-
-    g.tower_spots[0] = (tower_spot){.position = (vector2){5, 3}, .occupied = false};
-    g.tower_spots[1] = (tower_spot){.position = (vector2){8, 11}, .occupied = false};
-    g.tower_spots[2] = (tower_spot){.position = (vector2){15, 3}, .occupied = false};
-    g.tower_spots[3] = (tower_spot){.position = (vector2){15, 11}, .occupied = false};
-
-    g.assets.towers = load_texture(ASSETS_PATH "images/towers.png");
-    g.assets.mushroom_run = load_texture(ASSETS_PATH "images/Mushroom-Run.png");
-    g.assets.mushroom_hit = load_texture(ASSETS_PATH "images/Mushroom-Hit.png");
-    g.assets.mushroom_die = load_texture(ASSETS_PATH "images/Mushroom-Die.png");
-    g.assets.flying_fly = load_texture(ASSETS_PATH "images/Enemy3-Fly.png");
-    g.assets.flying_hit = load_texture(ASSETS_PATH "images/Enemy3-Hit.png");
-    g.assets.flying_die = load_texture(ASSETS_PATH "images/Enemy3-Die.png");
-    g.assets.iceball = load_texture(ASSETS_PATH "images/Iceball_84x9.png");
-    g.assets.start_screen = load_texture(ASSETS_PATH "images/start_screen.png");
-    g.assets.defeat_screen = load_texture(ASSETS_PATH "images/defeat_screen.png");
-
-    if (g.assets.towers.id == 0) {
-        fprintf(stderr, "error: failed to load towers texture\n");
-        free(g.game_objects);
-        unload_tilemap(&g.tilemap);
-        exit(1);
-    }
-
-    if (g.assets.mushroom_run.id == 0 || g.assets.flying_fly.id == 0) {
-        fprintf(stderr, "error: failed to load enemy textures\n");
-        free(g.game_objects);
-        unload_tilemap(&g.tilemap);
-        exit(1);
-    }
-
-    if (g.assets.iceball.id == 0) {
-        fprintf(stderr, "error: failed to load projectile texture\n");
-        free(g.game_objects);
-        unload_tilemap(&g.tilemap);
-        exit(1);
-    }
-
-    if (g.assets.start_screen.id == 0) {
-        fprintf(stderr, "error: failed to load start screen texture\n");
-        free(g.game_objects);
-        unload_tilemap(&g.tilemap);
-        exit(1);
-    }
-
-    if (g.assets.defeat_screen.id == 0) {
-        fprintf(stderr, "error: failed to load defeat screen texture\n");
-        free(g.game_objects);
-        unload_tilemap(&g.tilemap);
-        exit(1);
-    }
-
-    const result_code res = add_game_object(&g, init_tower(g.tower_spots[0].position));
+        free_game_state(g);
+        return result_error_out_of_memory;
+    }
+    g->player_money = STARTING_AMOUNT_OF_MONEY;
+    g->player_lives = STARTING_AMOUNT_OF_LIVES;
+    g->enemy_spawn_timer = 0.0f;
+    g->state = game_state_start;
+    g->enemies_defeated = 0;
+    g->rng_state = seed;
+    g->lazy_enemies = LAZY_ENEMY_POSITIONS;
+    g->enemies_placed_tick = UINT64_MAX;
+    g->object_limit = MAX_GAME_OBJECTS;
+    g->sim_speed = 1;
+
+    g->current_wave = -1;
+    g->enemies_spawned_in_wave = 0;
+    g->enemies_alive = 0;
+    g->wave_break_timer = 0.0f;
+
+    g->tower_spots[0] = (tower_spot){.position = (vector2){5, 3}, .occupied = false};
+    g->tower_spots[1] = (tower_spot){.position = (vector2){8, 11}, .occupied = false};
+    g->tower_spots[2] = (tower_spot){.position = (vector2){15, 3}, .occupied = false};
+    g->tower_spots[3] = (tower_spot){.position = (vector2){15, 11}, .occupied = false};
+
+    const result_code res = add_game_object(g, init_tower(g->tower_spots[0].position));
     if (res != result_ok) {
         fprintf(stderr, "ERROR: Failed to add initial tower: code %u\n", (unsigned)res);
-        free(g.game_objects);
-        unload_tilemap(&g.tilemap);
-        exit(1);
+        free_game_state(g);
+        return res;
     }
-    g.tower_spots[0].occupied = true;
+    g->tower_spots[0].occupied = true;
+
+    return result_ok;
+}
 
-    return g;
+size_t get_object_count(const game *g) {
+    VALIDATE_PTR_RET(g, 0);
+
+    return g->enemies.count - g->enemies.free_count +
+           g->towers.count - g->towers.free_count +
+           g->projectiles.count - g->projectiles.free_count;
+}
+
+pool_stats get_object_pool_stats(const game *g) {
+    pool_stats total = {0};
+    VALIDATE_PTR_RET(g, total);
+
+    const pool_stats* stores[] = {&g->enemies.stats, &g->towers.stats, &g->projectiles.stats};
+    for (size_t i = 0; i < sizeof(stores) / sizeof(stores[0]); i++) {
+        total.resizes += stores[i]->resizes;
+        total.bytes_moved += stores[i]->bytes_moved;
+        total.compactions += stores[i]->compactions;
+    }
+    return total;
 }
 
 result_code add_game_object(game *g, game_object obj) {
     VALIDATE_PTR_RET(g, result_error_null_ptr);
-    VALIDATE_PTR_RET(g->game_objects, result_error_null_ptr);
 
-    if (g->object_count >= MAX_GAME_OBJECTS) {
-        fprintf(stderr, "ERROR: Cannot add object - MAX_GAME_OBJECTS (%zu) limit reached\n", (size_t)MAX_GAME_OBJECTS);
+    if (get_object_count(g) >= g->object_limit) {
         return result_error_out_of_bounds;
     }
 
-    if (g->object_count == g->object_capacity) {
-        const result_code res = grow_object_capacity(g);
-        if (res != result_ok) {
-            return res;
-        }
+    size_t index;
+    switch (obj.type) {
+        case enemy:
+            index = enemy_store_next_slot(&g->enemies);
+            break;
+        case tower:
+            index = tower_store_next_slot(&g->towers);
+            break;
+        case projectile:
+            index = projectile_store_next_slot(&g->projectiles);
+            break;
+        default:
+            return result_error_invalid_state;
     }
 
-    obj.id = g->next_id;
-    g->game_objects[g->object_count] = obj;
-    g->object_count++;
-    g->next_id++;
+    obj.id = handle_table_acquire(&g->handles, obj.type, index);
+    if (obj.id == INVALID_HANDLE) {
+        return result_error_out_of_memory;
+    }
+    if (obj.type == enemy) {
+        obj.data.enemy.spawn_tick = g->tick;
+    }
+
+    result_code res;
+    switch (obj.type) {
+        case enemy:
+            res = enemy_store_push(&g->enemies, &obj);
+            break;
+        case tower:
+            res = tower_store_push(&g->towers, &obj);
+            break;
+        case projectile:
+            res = projectile_store_push(&g->projectiles, &obj);
+            break;
+        default:
+            res = result_error_invalid_state;
+            break;
+    }
+
+    if (res != result_ok) {
+        handle_table_release(&g->handles, obj.id);
+        return res;
+    }
+
+    if (obj.type == enemy && g->lazy_enemies) {
+        // A lazy enemy with no exit event would never leave the map
+        const result_code exit_res = schedule_enemy_exit(g, index);
+        if (exit_res != result_ok) {
+            enemy_store_release(&g->enemies, index, &g->handles);
+            return exit_res;
+        }
+    }
+    if (obj.type == enemy) {
+        target_index_insert(&g->targets, &g->enemies, index);
+    }
 
     return result_ok;
 }
 
-result_code grow_object_capacity(game* g) {
+result_code queue_spawn(game *g, const game_object obj) {
     VALIDATE_PTR_RET(g, result_error_null_ptr);
 
-    size_t new_capacity = g->object_capacity * 2;
-    if (new_capacity == 0) new_capacity = STARTING_COUNT_OF_GAME_OBJECTS;
+    return command_buffer_push_spawn(&g->commands, &obj);
+}
 
-    if (new_capacity > MAX_GAME_OBJECTS) {
-        new_capacity = MAX_GAME_OBJECTS;
-    }
+void apply_queued_spawns(game *g) {
+    VALIDATE_PTR(g);
 
-    if (new_capacity <= g->object_capacity) {
-        fprintf(stderr, "ERROR: Cannot grow capacity beyond MAX_GAME_OBJECTS (%zu)\n", (size_t)MAX_GAME_OBJECTS);
-        return result_error_out_of_bounds;
-    }
+    const command_buffer* commands = &g->commands;
 
-    game_object* temp = realloc(g->game_objects, sizeof(game_object) * new_capacity);
+    for (size_t i = 0; i < commands->count; i++) {
+        const game_object* obj = &commands->spawns[i];
+        const result_code res = add_game_object(g, *obj);
+        if (res == result_ok) {
+            continue;
+        }
 
-    if (temp == nullptr) {
-        fprintf(stderr, "ERROR: Failed to reallocate memory for game objects.\n");
-        return result_error_out_of_memory;
+        if (res != result_error_out_of_bounds) {
+            fprintf(stderr, "ERROR: Failed to apply queued spawn: code %u\n", (unsigned)res);
+        }
+        g->spawns_rejected++;
+        if (obj->type == enemy) {
+            g->enemies_spawned_in_wave--;
+            g->enemies_alive--;
+        }
     }
 
-    g->game_objects = temp;
-    g->object_capacity = new_capacity;
+    command_buffer_clear(&g->commands);
 
-    return result_ok;
+    if (g->spawns_rejected > g->spawns_rejected_reported && g->tick >= g->spawn_warning_tick) {
+        fprintf(stderr, "WARNING: %zu spawns dropped at the object limit (%zu)\n",
+                g->spawns_rejected - g->spawns_rejected_reported, g->object_limit);
+        g->spawns_rejected_reported = g->spawns_rejected;
+        g->spawn_warning_tick = g->tick + SIM_TICK_RATE;
+    }
 }
 
-void start_game(game *g) {
-    if (g == nullptr || g->game_objects == nullptr) exit(1);
-
-    while (!window_should_close()) {
-        const float delta_time = get_frame_time();
+// Room for one more enemy once everything queued this tick lands; a command
+// buffer's worth of the limit is kept free for tower shots
+static bool has_spawn_room(const game *g) {
+    const size_t reserved = g->object_limit > COMMAND_BUFFER_CAPACITY ? COMMAND_BUFFER_CAPACITY : 0;
+    return get_object_count(g) + g->commands.count + reserved < g->object_limit &&
+           g->commands.count < g->commands.capacity;
+}
 
-        if (g->state == game_state_start && is_key_pressed(key_space)) {
-            start_next_wave(g);
-            g->state = game_state_playing;
-        }
-        else if (g->state == game_state_playing) {
-            if (g->player_lives <= 0) g->state = game_state_game_over;
+int sim_clock_advance(sim_clock *clock, const float frame_time) {
+    VALIDATE_PTR_RET(clock, 0);
 
-            handle_playing_input(g);
+    const int speed = clock->speed > 0 ? clock->speed : 1;
+    if (frame_time > 0.0f) {
+        clock->accumulator += frame_time * (float)speed;
+    }
 
-            const wave_config current_wave = get_wave_config(g->current_wave);
+    int steps = 0;
+    while (clock->accumulator >= SIM_TICK_DURATION && steps < MAX_SIM_STEPS_PER_FRAME * speed) {
+        clock->accumulator -= SIM_TICK_DURATION;
+        steps++;
+    }
 
-            if (g->enemies_spawned_in_wave < current_wave.enemy_count) {
-                g->enemy_spawn_timer -= delta_time;
-                if (g->enemy_spawn_timer <= 0) {
-                    spawn_enemy(g);
-                    g->enemy_spawn_timer = current_wave.spawn_interval;
-                }
-            }
+    // Drop whatever a long stall left behind instead of spiralling into it
+    clock->dropped = 0;
+    if (clock->accumulator >= SIM_TICK_DURATION) {
+        clock->dropped = (int)(clock->accumulator / SIM_TICK_DURATION);
+        clock->accumulator = 0.0f;
+    }
 
-            else if (g->enemies_alive == 0) {
-                g->state = game_state_wave_break;
-                g->wave_break_timer = WAVE_BREAK_DURATION;
-            }
+    clock->alpha = clock->accumulator / SIM_TICK_DURATION;
+    return steps;
+}
 
-            update_game_state(g, delta_time);
-        }
-        else if (g->state == game_state_wave_break) {
-            handle_playing_input(g);
-            update_game_state(g, delta_time);
-
-            g->wave_break_timer -= delta_time;
-            if (g->wave_break_timer <= 0 || is_key_pressed(key_space)) {
-                start_next_wave(g);
-                g->state = game_state_playing;
-            }
-        }
-        else if (g->state == game_state_game_over && is_key_pressed(key_space)) {
-            reset_game(g);
-            start_next_wave(g);
-            g->state = game_state_playing;
-        }
+void cycle_sim_speed(game *g) {
+    VALIDATE_PTR(g);
 
-        begin_drawing();
-        clear_background(black);
-        draw_tilemap(&g->tilemap);
+    static const int speeds[] = {1, 2, 4, 16};
+    constexpr size_t speed_count = sizeof(speeds) / sizeof(speeds[0]);
 
-        if (g->state == game_state_playing) {
-            draw_tower_spots(g);
+    size_t next = 0;
+    for (size_t i = 0; i < speed_count; i++) {
+        if (speeds[i] == g->sim_speed) {
+            next = (i + 1) % speed_count;
+            break;
         }
+    }
+    g->sim_speed = speeds[next];
+}
 
-        draw_game_objects(g);
-
-        if (g->state == game_state_start) {
-            draw_start_screen(g);
-        }
-        else if (g->state == game_state_playing) {
-            draw_hud(g);
-            draw_wave_info(g);
-
-            const grid_coord mouse_grid = screen_to_grid(get_mouse_position(), &g->tilemap);
-            const game_object* hovered_tower = find_tower_at_grid(g, mouse_grid);
-            if (hovered_tower != nullptr) {
-                const vector2 mouse_pos = get_mouse_position();
-                draw_tower_info(hovered_tower, (int)mouse_pos.x + 15, (int)mouse_pos.y + 15);
-            }
-        }
-        else if (g->state == game_state_wave_break) {
-            draw_hud(g);
-            draw_wave_info(g);
-            draw_wave_break_screen(g);
-        }
-        else if (g->state == game_state_game_over) {
-            draw_hud(g);
-            draw_game_over_screen(g);
-        }
+// Keeps the last non-zero drop count on screen for a moment so a frame that
+// fell behind is visible
+void record_dropped_steps(game *g, const int dropped, const float frame_time) {
+    VALIDATE_PTR(g);
 
-        draw_fps(10, 10);
-        end_drawing();
+    if (dropped > 0) {
+        g->dropped_steps = dropped;
+        g->dropped_steps_timer = SIM_DROPPED_DISPLAY_SECONDS;
+    }
+    else if (g->dropped_steps_timer > 0.0f) {
+        g->dropped_steps_timer -= frame_time;
     }
-    unload_game(g);
 }
 
-void unload_game(game *g) {
+uint64_t sim_ticks_from_seconds(const float seconds) {
+    const long ticks = lroundf(seconds * (float)SIM_TICK_RATE);
+    return ticks < 1 ? 1 : (uint64_t)ticks;
+}
+
+void simulate_tick(game *g) {
     if (g == nullptr) return;
 
-    unload_tilemap(&g->tilemap);
-    free(g->game_objects);
-    unload_texture(g->assets.towers);
-    unload_texture(g->assets.mushroom_run);
-    unload_texture(g->assets.mushroom_hit);
-    unload_texture(g->assets.mushroom_die);
-    unload_texture(g->assets.flying_fly);
-    unload_texture(g->assets.flying_hit);
-    unload_texture(g->assets.flying_die);
-    unload_texture(g->assets.iceball);
-    unload_texture(g->assets.start_screen);
-    unload_texture(g->assets.defeat_screen);
-    g->game_objects = nullptr;
-}
+    if (g->state == game_state_playing) {
+        if (g->player_lives <= 0) {
+            g->state = game_state_game_over;
+            return;
+        }
 
-grid_coord screen_to_grid(const vector2 screen_pos, const tile_map* tilemap) {
-    if (tilemap == nullptr) {
-        return (grid_coord){.x = 0, .y = 0};
-    }
+        const wave_config current_wave = get_game_wave_config(g, g->current_wave);
 
-    const int scaled_tile_size = get_tile_scale(tilemap);
+        if (g->enemies_spawned_in_wave < current_wave.enemy_count) {
+            g->enemy_spawn_timer -= SIM_TICK_DURATION;
 
-    grid_coord grid_pos;
-    grid_pos.x = (int)(screen_pos.x / (float)scaled_tile_size);
-    grid_pos.y = (int)(screen_pos.y / (float)scaled_tile_size);
+            // A full game holds the spawn back until enemies leave instead of
+            // dropping it, so the wave still sends its whole count
+            if (g->enemy_spawn_timer <= 0 && has_spawn_room(g)) {
+                const int batch = current_wave.spawn_batch > 0 ? current_wave.spawn_batch : 1;
+                for (int i = 0; i < batch && g->enemies_spawned_in_wave < current_wave.enemy_count &&
+                                has_spawn_room(g); i++) {
+                    spawn_enemy(g);
+                }
+                g->enemy_spawn_timer = current_wave.spawn_interval;
+            }
+        }
 
-    return grid_pos;
-}
+        else if (g->enemies_alive == 0 && !g->external_wave_end) {
+            g->state = game_state_wave_break;
+            g->wave_break_timer = WAVE_BREAK_DURATION;
+        }
 
-/**
- * IMPORTANT: The caller is responsible for freeing the memory allocated for 'out_objects'
- * @return The number of objects found, or -1 on memory allocation failure.
- */
-int get_game_objects_of_type(const game *g, const object_type type, game_object **out_objects) {
-    if (g == nullptr || out_objects == nullptr) {
-        return -1;
+        update_game_state(g, SIM_TICK_DURATION);
     }
+    else if (g->state == game_state_wave_break) {
+        update_game_state(g, SIM_TICK_DURATION);
 
-    int count = 0;
-    for (size_t i = 0; i < g->object_count;i++) {
-        if (g->game_objects[i].type == type) {
-            count++;
+        g->wave_break_timer -= SIM_TICK_DURATION;
+        if (g->wave_break_timer <= 0) {
+            start_next_wave(g);
+            g->state = game_state_playing;
         }
     }
-    if (count == 0) {
-        *out_objects = nullptr;
-        return 0;
+}
+
+// Only towers picking a target and projectiles in flight look enemies up by
+// position; on other ticks lazy enemies are left where they were last placed
+static bool needs_enemy_positions(const game *g) {
+    if (!g->lazy_enemies) {
+        return true;
     }
 
-    *out_objects = malloc(sizeof(game_object) * count);
+    const tower_schedule* schedule = &g->tower_schedule;
+    return schedule->ready_count > 0 ||
+           event_heap_has_due(&schedule->reloading, g->tick) ||
+           g->projectiles.count > g->projectiles.free_count;
+}
 
-    if (*out_objects == nullptr) {
-        fprintf(stderr, "ERROR: Failed to allocate memory for game objects array.\n");
-        return -1;
-    }
+void update_game_state(game *g, const float delta_time) {
+    if (g == nullptr) return;
 
-    int current_index = 0;
-    for (size_t i = 0; i < g->object_count; i++) {
-        if (g->game_objects[i].type == type) {
-            (*out_objects)[current_index] = g->game_objects[i];
-            current_index++;
-        }
+    g->tick++;
+    projectile_store_save_positions(&g->projectiles);
+
+    if (g->lazy_enemies) {
+        update_lazy_enemies(g);
+    }
+    else {
+        enemy_store_save_positions(&g->enemies);
+        update_enemies(&g->enemies, delta_time);
     }
+    update_death_fx(&g->death_effects, delta_time);
 
-    return count;
-}
+    if (needs_enemy_positions(g)) {
+        place_lazy_enemies(g);
 
-void update_game_state(game *g, const float delta_time) {
-    if (g == nullptr || g->game_objects == nullptr) return;
-
-    for (size_t i = 0; i < g->object_count; i++ ) {
-        switch (g->game_objects[i].type) {
-            case enemy:
-                update_enemy(&g->game_objects[i], delta_time);
-                break;
-            case tower:
-                update_tower(g, &g->game_objects[i], delta_time);
-                break;
-            case projectile:
-                update_projectile(g, &g->game_objects[i], delta_time);
-                break;
-            default:
-                break;
+        if (spatial_grid_build(&g->enemy_grid, &g->enemies) != result_ok) {
+            fprintf(stderr, "ERROR: Failed to rebuild enemy grid\n");
+            return;
         }
     }
 
+    update_towers(g);
+    update_projectiles(g, delta_time);
+    update_impacts(g);
+
+    apply_queued_spawns(g);
     remove_inactive_objects(g);
 }
 
 int find_tower_spot_at_grid(const game *g, const grid_coord coord) {
     if (g == nullptr) return -1;
 
-    for (int i = 0; i < 4; i++) {
+    for (int i = 0; i < TOWER_SPOT_COUNT; i++) {
         const tower_spot* spot = &g->tower_spots[i];
         const int spot_x = (int)spot->position.x;
         const int spot_y = (int)spot->position.y;
@@ -483,7 +539,7 @@ int find_tower_spot_at_grid(const game *g, const grid_coord coord) {
 bool try_build_tower(game *g, const int spot_index) {
     if (g == nullptr) return false;
 
-    if (spot_index < 0 || spot_index >= 4) {
+    if (spot_index < 0 || spot_index >= TOWER_SPOT_COUNT) {
         fprintf(stderr, "ERROR: Invalid tower spot index: %d\n", spot_index);
         return false;
     }
@@ -510,20 +566,16 @@ bool try_build_tower(game *g, const int spot_index) {
     return true;
 }
 
-game_object* find_tower_at_grid(const game *g, const grid_coord coord) {
-    if (g == nullptr || g->game_objects == nullptr) return nullptr;
-
-    for (size_t i = 0; i < g->object_count; i++) {
-        if (g->game_objects[i].type != tower) {
-            continue;
-        }
+int find_tower_at_grid(const game *g, const grid_coord coord) {
+    if (g == nullptr) return -1;
 
-        game_object* twr = &g->game_objects[i];
+    const tower_store* towers = &g->towers;
 
-        const int tower_grid_x = (int)twr->position.x;
-        const int tower_grid_y = (int)twr->position.y;
-        const int tower_width  = twr->data.tower.width;
-        const int tower_height = twr->data.tower.height;
+    for (size_t i = 0; i < towers->count; i++) {
+        const int tower_grid_x = (int)towers->pos_x[i];
+        const int tower_grid_y = (int)towers->pos_y[i];
+        const int tower_width  = towers->width[i];
+        const int tower_height = towers->height[i];
 
         const bool is_inside = coord.x >= tower_grid_x &&
                                coord.x < tower_grid_x + tower_width &&
@@ -531,53 +583,67 @@ game_object* find_tower_at_grid(const game *g, const grid_coord coord) {
                                coord.y < tower_grid_y + tower_height;
 
         if (is_inside) {
-            return twr;
+            return (int)i;
         }
     }
-    return nullptr;
+    return -1;
 }
 
-void remove_inactive_objects(game *g) {
-    if (g == nullptr || g->game_objects == nullptr) return;
-
-    size_t write_index = 0;
-    for (size_t read_index = 0; read_index < g->object_count; read_index++) {
-        const game_object* obj = &g->game_objects[read_index];
-
-        if (!obj->is_active) {
-            if (obj->type == enemy) {
-                g->enemies_alive--;
-                if (obj->data.enemy.health <= 0) {
-                    g->enemies_defeated++;
-                    g->player_money += obj->data.enemy.gold_reward;
-                }
-                else {
-                    g->player_lives--;
-                }
-            }
-            continue;
-        }
+void defeat_enemy(game *g, const size_t index) {
+    VALIDATE_PTR(g);
 
-        if (write_index != read_index) {
-            g->game_objects[write_index] = g->game_objects[read_index];
-        }
-        write_index++;
+    enemy_store* enemies = &g->enemies;
+    if (!enemies->is_active[index]) {
+        return;
     }
 
-    g->object_count = write_index;
+    if (g->lazy_enemies) {
+        place_lazy_enemy(g, index);
+    }
 
-    if (g->object_capacity > (size_t)STARTING_COUNT_OF_GAME_OBJECTS * 2 &&
-        g->object_count < g->object_capacity / 4) {
+    const death_fx fx = {
+        .position = {enemies->pos_x[index], enemies->pos_y[index]},
+        .anim = enemies->type[index],
+        .frame = 0,
+        .frame_timer = 0.0f
+    };
+    if (fx_pool_push(&g->death_effects, &fx) != result_ok) {
+        fprintf(stderr, "WARNING: Failed to queue death animation\n");
+    }
 
-        const size_t new_capacity = g->object_capacity / 2;
+    g->enemies_alive--;
+    g->enemies_defeated++;
+    g->player_money += enemies->gold_reward[index];
+    target_index_remove(&g->targets, enemies->ids[index]);
+    enemy_store_release(enemies, index, &g->handles);
+}
 
-        game_object* temp = realloc(g->game_objects, sizeof(game_object) * new_capacity);
+void remove_inactive_objects(game *g) {
+    if (g == nullptr) return;
+
+    enemy_store* enemies = &g->enemies;
 
-        if (temp != nullptr) {
-            g->game_objects = temp;
-            g->object_capacity = new_capacity;
-        } else {
-            fprintf(stderr, "WARNING: Failed to compact object array\n");
+    // Killed enemies were settled by defeat_enemy; retired ones walked off the map
+    for (size_t i = 0; i < enemies->retired_count; i++) {
+        const size_t index = enemies->retired[i];
+        if (enemies->ids[index] == INVALID_HANDLE) {
+            continue;
         }
+
+        g->enemies_alive--;
+        g->player_lives--;
+        target_index_remove(&g->targets, enemies->ids[index]);
+        enemy_store_release(enemies, index, &g->handles);
     }
+    enemies->retired_count = 0;
+
+    projectile_store* projectiles = &g->projectiles;
+
+    for (size_t i = 0; i < projectiles->retired_count; i++) {
+        projectile_store_release(projectiles, projectiles->retired[i], &g->handles);
+    }
+    projectiles->retired_count = 0;
+
+    enemy_store_maintain(&g->enemies, &g->handles);
+    projectile_store_maintain(&g->projectiles, &g->handles);
 }
@@ -5,30 +5,63 @@
 #ifndef PROJEKT_GAME_H
 #define PROJEKT_GAME_H
 #include <stddef.h>
+#include <stdint.h>
 #include <assert.h>
 
 #include "tilemap.h"
 #include "game_object.h"
+#include "object_store.h"
+#include "spatial_grid.h"
+#include "command_buffer.h"
+#include "target_index.h"
+#include "fx_pool.h"
+#include "tower.h"
+#include "projectile.h"
 
 // Game object limits
 #define STARTING_COUNT_OF_GAME_OBJECTS 32
 #define MAX_GAME_OBJECTS 8192
+#define COMMAND_BUFFER_CAPACITY 512
+
+// Endless mode raises the object limit; enemy and projectile stores reserve
+// room for this many rows from the start so they never have to move
+#define ENDLESS_MAX_GAME_OBJECTS (1 << 18)
 
 // Compile-time validation of game object limits
 static_assert(MAX_GAME_OBJECTS >= STARTING_COUNT_OF_GAME_OBJECTS,
               "MAX_GAME_OBJECTS must be >= STARTING_COUNT_OF_GAME_OBJECTS");
 static_assert(MAX_GAME_OBJECTS <= 100000,
               "MAX_GAME_OBJECTS too large - potential memory issue");
+static_assert(ENDLESS_MAX_GAME_OBJECTS * 2 + MAX_GAME_OBJECTS <= HANDLE_MAX_SLOTS,
+              "Handle table cannot address every endless mode object");
 
 // Economy constants
 #define STARTING_AMOUNT_OF_MONEY 250
 #define STARTING_AMOUNT_OF_LIVES 100
 #define TOWER_BUILD_COST 100
+#define TOWER_SPOT_COUNT 4
 
 // Wave configuration
 #define MAX_WAVES 10
 #define WAVE_BREAK_DURATION 10.0f
 
+// Endless waves spawn a batch of enemies every tick for HORDE_SPAWN_SECONDS;
+// the batch grows each wave up to HORDE_MAX_SPAWN_BATCH
+#define HORDE_SPAWN_SECONDS 20
+#define HORDE_SPAWN_BATCH_STEP 16
+#define HORDE_MAX_SPAWN_BATCH 256
+
+static_assert(HORDE_MAX_SPAWN_BATCH < COMMAND_BUFFER_CAPACITY,
+              "A spawn batch must leave room in the command buffer for projectiles");
+
+// Simulation timing
+#define SIM_TICK_RATE 60
+#define SIM_TICK_DURATION (1.0f / (float)SIM_TICK_RATE)
+#define MAX_SIM_STEPS_PER_FRAME 5
+#define SIM_FRAME_BUDGET_SECONDS 0.010
+#define SIM_DROPPED_DISPLAY_SECONDS 1.0f
+#define LAZY_ENEMY_POSITIONS true
+
 // Safety validation macros
 #define VALIDATE_PTR(ptr) if (!(ptr)) return
 #define VALIDATE_PTR_RET(ptr, ret) if (!(ptr)) return (ret)
@@ -36,6 +69,7 @@ static_assert(MAX_GAME_OBJECTS <= 100000,
 typedef struct {
     int enemy_count;
     float spawn_interval;
+    int spawn_batch;
     int flying_chance;
     bool allow_bottom_path;
 } wave_config;
@@ -47,14 +81,6 @@ typedef enum {
     game_state_game_over
 } game_state;
 
-typedef enum {
-    result_ok,
-    result_error_null_ptr,
-    result_error_out_of_bounds,
-    result_error_out_of_memory,
-    result_error_invalid_state
-} result_code;
-
 typedef struct {
     texture_2d towers;
     texture_2d mushroom_run;
@@ -73,20 +99,37 @@ typedef struct {
     bool occupied;
 } tower_spot;
 
+// Accumulates real frame time and hands it out as fixed simulation ticks.
+// alpha is how far the frame sits between the last two ticks, for rendering.
+// speed scales frame time for fast forward; dropped is how many ticks the
+// last advance threw away because they did not fit in one frame.
+typedef struct {
+    float accumulator;
+    float alpha;
+    int speed;
+    int dropped;
+} sim_clock;
+
 typedef struct game {
-    game_object *game_objects;
+    enemy_store enemies;
+    tower_store towers;
+    projectile_store projectiles;
+    handle_table handles;
+    spatial_grid enemy_grid;
+    command_buffer commands;
+    tower_schedule tower_schedule;
+    impact_schedule impacts;
+    target_index targets;
+    fx_pool death_effects;
+    event_heap enemy_exits;
     tile_map tilemap;
     assets assets;
 
-    size_t object_count;
-    size_t object_capacity;
-
     int player_lives;
     int player_money;
-    int next_id;
     float enemy_spawn_timer;
 
-    tower_spot tower_spots[4];
+    tower_spot tower_spots[TOWER_SPOT_COUNT];
 
     int current_wave;
     int enemies_spawned_in_wave;
@@ -95,24 +138,64 @@ typedef struct game {
 
     game_state state;
     int enemies_defeated;
+
+    uint64_t tick;
+    unsigned int rng_state;
+    float render_alpha;
+
+    // Lazy enemies are placed from their spawn tick and speed only when a
+    // query needs them; they leave the map through enemy_exits
+    bool lazy_enemies;
+    uint64_t enemies_placed_tick;
+
+    // Spawns past object_limit are dropped and reported at most once a second
+    bool endless;
+    size_t object_limit;
+    size_t spawns_rejected;
+    size_t spawns_rejected_reported;
+    uint64_t spawn_warning_tick;
+
+    // Multiplayer ends a wave only once both players have finished it, so
+    // simulate_tick leaves a finished wave playing for the caller to end
+    bool external_wave_end;
+
+    // Fast forward multiplier and the ticks recently dropped to keep up
+    int sim_speed;
+    int dropped_steps;
+    float dropped_steps_timer;
 } game;
 
 game init_game();
+result_code init_game_state(game *g, unsigned int seed);
+void free_game_state(game *g);
 result_code add_game_object(game *g, game_object obj);
-result_code grow_object_capacity(game *g);
+result_code queue_spawn(game *g, game_object obj);
+void apply_queued_spawns(game *g);
+size_t get_object_count(const game *g);
+pool_stats get_object_pool_stats(const game *g);
 void start_game(game *g);
 void unload_game(game *g);
 grid_coord screen_to_grid(vector2 screen_pos, const tile_map* tilemap);
-int get_game_objects_of_type(const game *g, object_type type, game_object **out_objects);
 void update_game_state(game *g, float delta_time);
 void remove_inactive_objects(game *g);
-game_object* find_tower_at_grid(const game *g, grid_coord coord);
+void defeat_enemy(game *g, size_t index);
+int find_tower_at_grid(const game *g, grid_coord coord);
 int find_tower_spot_at_grid(const game *g, grid_coord coord);
 bool try_build_tower(game *g, int spot_index);
 wave_config get_wave_config(int wave_number);
+wave_config get_horde_wave_config(int wave_number);
+wave_config get_game_wave_config(const game *g, int wave_number);
+void enable_endless_mode(game *g);
 void start_next_wave(game *g);
+bool is_wave_finished(const game *g);
 void handle_playing_input(game *g);
 void spawn_enemy(game *g);
 void reset_game(game *g);
+int game_random_value(game *g, int min, int max);
+int sim_clock_advance(sim_clock *clock, float frame_time);
+void cycle_sim_speed(game *g);
+void record_dropped_steps(game *g, int dropped, float frame_time);
+uint64_t sim_ticks_from_seconds(float seconds);
+void simulate_tick(game *g);
 
 #endif //PROJEKT_GAME_H
@@ -0,0 +1,261 @@
+#include "game.h"
+#include "tower.h"
+#include "renderer.h"
+#include "raylib.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+void handle_playing_input(game *g) {
+    if (g == nullptr) return;
+
+    const grid_coord grid_pos = screen_to_grid(get_mouse_position(), &g->tilemap);
+
+    const int hovered_tower = find_tower_at_grid(g, grid_pos);
+    const int spot_index = find_tower_spot_at_grid(g, grid_pos);
+
+    if (hovered_tower >= 0 || spot_index >= 0) {
+        use_pointer_cursor();
+    } else {
+        use_normal_cursor();
+    }
+
+    if (is_mouse_button_pressed(mouse_button_left)) {
+        const upgrade_result result = upgrade_clicked_tower(g, grid_pos);
+        switch (result) {
+            case upgrade_success:
+            case upgrade_insufficient_funds:
+            case upgrade_max_level:
+                break;
+            case upgrade_not_found:
+                if (spot_index >= 0) {
+                    try_build_tower(g, spot_index);
+                }
+                break;
+            default:
+                break;
+        }
+    }
+
+    if (is_mouse_button_pressed(mouse_button_right)) {
+        cycle_clicked_tower_policy(g, grid_pos);
+    }
+
+    if (is_key_pressed(key_f)) {
+        cycle_sim_speed(g);
+    }
+}
+
+// Everything drawn on the board shares one atlas so a frame's sprites batch
+// together; the full screen start and defeat images stay separate textures
+enum {
+    board_tileset1,
+    board_tileset2,
+    board_towers,
+    board_mushroom_run,
+    board_mushroom_hit,
+    board_mushroom_die,
+    board_flying_fly,
+    board_flying_hit,
+    board_flying_die,
+    board_iceball,
+    BOARD_TEXTURE_COUNT
+};
+
+static const char* const board_texture_files[BOARD_TEXTURE_COUNT] = {
+    [board_tileset1] = TILESET1_PATH,
+    [board_tileset2] = TILESET2_PATH,
+    [board_towers] = ASSETS_PATH "images/towers.png",
+    [board_mushroom_run] = ASSETS_PATH "images/Mushroom-Run.png",
+    [board_mushroom_hit] = ASSETS_PATH "images/Mushroom-Hit.png",
+    [board_mushroom_die] = ASSETS_PATH "images/Mushroom-Die.png",
+    [board_flying_fly] = ASSETS_PATH "images/Enemy3-Fly.png",
+    [board_flying_hit] = ASSETS_PATH "images/Enemy3-Hit.png",
+    [board_flying_die] = ASSETS_PATH "images/Enemy3-Die.png",
+    [board_iceball] = ASSETS_PATH "images/Iceball_84x9.png",
+};
+
+static void unload_board_textures(const game *g) {
+    const texture_2d board[BOARD_TEXTURE_COUNT] = {
+        g->tilemap.tileset1, g->tilemap.tileset2, g->assets.towers,
+        g->assets.mushroom_run, g->assets.mushroom_hit, g->assets.mushroom_die,
+        g->assets.flying_fly, g->assets.flying_hit, g->assets.flying_die,
+        g->assets.iceball,
+    };
+    unload_texture_atlas(board, BOARD_TEXTURE_COUNT);
+}
+
+game init_game() {
+    game g = {0};
+    const unsigned int seed = (unsigned int)get_random_value(0, 0x7FFF) << 16 | (unsigned int)get_random_value(0, 0xFFFF);
+    if (init_game_state(&g, seed) != result_ok) {
+        exit(1);
+    }
+
+    texture_2d board[BOARD_TEXTURE_COUNT] = {0};
+    if (!load_texture_atlas(board_texture_files, BOARD_TEXTURE_COUNT, board)) {
+        fprintf(stderr, "error: failed to build board texture atlas\n");
+        free_game_state(&g);
+        exit(1);
+    }
+    g.tilemap = init_tilemap(board[board_tileset1], board[board_tileset2]);
+
+    g.assets.towers = board[board_towers];
+    g.assets.mushroom_run = board[board_mushroom_run];
+    g.assets.mushroom_hit = board[board_mushroom_hit];
+    g.assets.mushroom_die = board[board_mushroom_die];
+    g.assets.flying_fly = board[board_flying_fly];
+    g.assets.flying_hit = board[board_flying_hit];
+    g.assets.flying_die = board[board_flying_die];
+    g.assets.iceball = board[board_iceball];
+    g.assets.start_screen = load_texture(ASSETS_PATH "images/start_screen.png");
+    g.assets.defeat_screen = load_texture(ASSETS_PATH "images/defeat_screen.png");
+
+    if (g.assets.towers.id == 0) {
+        fprintf(stderr, "error: failed to load towers texture\n");
+        free_game_state(&g);
+        unload_board_textures(&g);
+        exit(1);
+    }
+
+    if (g.assets.mushroom_run.id == 0 || g.assets.flying_fly.id == 0) {
+        fprintf(stderr, "error: failed to load enemy textures\n");
+        free_game_state(&g);
+        unload_board_textures(&g);
+        exit(1);
+    }
+
+    if (g.assets.iceball.id == 0) {
+        fprintf(stderr, "error: failed to load projectile texture\n");
+        free_game_state(&g);
+        unload_board_textures(&g);
+        exit(1);
+    }
+
+    if (g.assets.start_screen.id == 0) {
+        fprintf(stderr, "error: failed to load start screen texture\n");
+        free_game_state(&g);
+        unload_board_textures(&g);
+        exit(1);
+    }
+
+    if (g.assets.defeat_screen.id == 0) {
+        fprintf(stderr, "error: failed to load defeat screen texture\n");
+        free_game_state(&g);
+        unload_board_textures(&g);
+        exit(1);
+    }
+
+    return g;
+}
+
+void start_game(game *g) {
+    if (g == nullptr) exit(1);
+
+    sim_clock clock = {0};
+    hud_labels hud = {0};
+
+    while (!window_should_close()) {
+        const float frame_time = get_frame_time();
+        clock.speed = g->sim_speed;
+        const int steps = sim_clock_advance(&clock, frame_time);
+
+        if (g->state == game_state_start && (is_key_pressed(key_space) || is_key_pressed(key_e))) {
+            if (is_key_pressed(key_e)) {
+                enable_endless_mode(g);
+            }
+            start_next_wave(g);
+            g->state = game_state_playing;
+        }
+        else if (g->state == game_state_playing) {
+            handle_playing_input(g);
+        }
+        else if (g->state == game_state_wave_break) {
+            handle_playing_input(g);
+
+            if (is_key_pressed(key_space)) {
+                start_next_wave(g);
+                g->state = game_state_playing;
+            }
+        }
+        else if (g->state == game_state_game_over && is_key_pressed(key_space)) {
+            reset_game(g);
+            start_next_wave(g);
+            g->state = game_state_playing;
+        }
+
+        // Fast forward stops short of the frame budget so rendering keeps its
+        // rate; the ticks left over are dropped like a stall would drop them
+        const double budget_end = get_time() + SIM_FRAME_BUDGET_SECONDS;
+        int step = 0;
+        while (step < steps && (step == 0 || get_time() < budget_end)) {
+            simulate_tick(g);
+            step++;
+        }
+        record_dropped_steps(g, clock.dropped + steps - step, frame_time);
+        g->render_alpha = clock.alpha;
+
+        begin_drawing();
+        clear_background(black);
+        draw_tilemap(&g->tilemap);
+
+        if (g->state == game_state_playing) {
+            draw_tower_spots(g);
+        }
+
+        draw_game_objects(g);
+
+        if (g->state == game_state_start) {
+            draw_start_screen(g);
+        }
+        else if (g->state == game_state_playing) {
+            draw_hud(g, &hud);
+            draw_wave_info(g, &hud);
+
+            const grid_coord mouse_grid = screen_to_grid(get_mouse_position(), &g->tilemap);
+            const int hovered_tower = find_tower_at_grid(g, mouse_grid);
+            if (hovered_tower >= 0) {
+                const vector2 mouse_pos = get_mouse_position();
+                draw_tower_info(g, &hud, hovered_tower, (int)mouse_pos.x + 15, (int)mouse_pos.y + 15);
+            }
+        }
+        else if (g->state == game_state_wave_break) {
+            draw_hud(g, &hud);
+            draw_wave_info(g, &hud);
+            draw_wave_break_screen(g);
+        }
+        else if (g->state == game_state_game_over) {
+            draw_hud(g, &hud);
+            draw_game_over_screen(g);
+        }
+
+        draw_fps(10, 10);
+        end_drawing();
+    }
+    unload_hud(&hud);
+    unload_game(g);
+}
+
+void unload_game(game *g) {
+    if (g == nullptr) return;
+
+    unload_tilemap(&g->tilemap);
+    free_game_state(g);
+    unload_board_textures(g);
+    unload_texture(g->assets.start_screen);
+    unload_texture(g->assets.defeat_screen);
+}
+
+grid_coord screen_to_grid(const vector2 screen_pos, const tile_map* tilemap) {
+    if (tilemap == nullptr) {
+        return (grid_coord){.x = 0, .y = 0};
+    }
+
+    const int scaled_tile_size = get_tile_scale(tilemap);
+
+    grid_coord grid_pos;
+    grid_pos.x = (int)(screen_pos.x / (float)scaled_tile_size);
+    grid_pos.y = (int)(screen_pos.y / (float)scaled_tile_size);
+
+    return grid_pos;
+}
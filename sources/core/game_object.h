@@ -1,7 +1,9 @@
 #ifndef PROJEKT_GAME_OBJECT_H
 #define PROJEKT_GAME_OBJECT_H
 
-#include <raylib.h>
+#include <stdint.h>
+
+#include "raylib_types.h"
 
 typedef enum {
     tower,
@@ -15,6 +17,20 @@ typedef enum {
     level_max
 } tower_level;
 
+typedef enum {
+    tower_fire_projectile,
+    tower_fire_analytic
+} tower_fire_mode;
+
+typedef enum {
+    target_policy_nearest,
+    target_policy_first,
+    target_policy_last,
+    target_policy_strongest,
+    target_policy_weakest,
+    target_policy_count
+} tower_target_policy;
+
 typedef enum {
     enemy_type_mushroom,
     enemy_type_flying,
@@ -27,6 +43,14 @@ typedef enum {
     enemy_anim_die
 } enemy_animation_state;
 
+typedef enum {
+    result_ok,
+    result_error_null_ptr,
+    result_error_out_of_bounds,
+    result_error_out_of_memory,
+    result_error_invalid_state
+} result_code;
+
 typedef enum {
     upgrade_success,
     upgrade_insufficient_funds,
@@ -55,12 +79,15 @@ typedef struct {
     int height;
     int upgrade_cost;
     tower_level level;
+    tower_fire_mode fire_mode;
+    tower_target_policy target_policy;
 } tower_data;
 
 typedef struct {
     float health;
     float max_health;
     float speed;
+    float distance;
     int waypoint_index;
     int path_id;
     int gold_reward;
@@ -68,6 +95,8 @@ typedef struct {
     enemy_animation_state anim_state;
     int current_frame;
     float frame_timer;
+    uint64_t spawn_tick;
+    uint64_t hit_tick;
 } enemy_data;
 
 typedef struct {
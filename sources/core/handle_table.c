@@ -0,0 +1,110 @@
+#include "handle_table.h"
+#include "game.h"
+#include "vm_region.h"
+
+#include <stdio.h>
+
+#define HANDLE_GENERATION_MASK ((1u << HANDLE_GENERATION_BITS) - 1u)
+
+static int make_handle(const uint32_t slot, const uint32_t generation) {
+    return (int)((generation << HANDLE_INDEX_BITS) | slot);
+}
+
+static uint32_t handle_generation(const int handle) {
+    return ((uint32_t)handle >> HANDLE_INDEX_BITS) & HANDLE_GENERATION_MASK;
+}
+
+// All slot arrays are reserved for max_slots up front; pages are only backed
+// once a slot is first handed out.
+result_code handle_table_init(handle_table *table, const size_t max_slots) {
+    VALIDATE_PTR_RET(table, result_error_null_ptr);
+
+    *table = (handle_table){0};
+    table->capacity = max_slots < HANDLE_MAX_SLOTS ? max_slots : HANDLE_MAX_SLOTS;
+
+    table->generations = vm_region_reserve(sizeof(uint32_t) * table->capacity);
+    table->dense_index = vm_region_reserve(sizeof(uint32_t) * table->capacity);
+    table->types = vm_region_reserve(sizeof(object_type) * table->capacity);
+    table->in_use = vm_region_reserve(sizeof(bool) * table->capacity);
+    table->free_slots = vm_region_reserve(sizeof(uint32_t) * table->capacity);
+
+    if (table->generations == nullptr || table->dense_index == nullptr || table->types == nullptr ||
+        table->in_use == nullptr || table->free_slots == nullptr) {
+        return result_error_out_of_memory;
+    }
+    return result_ok;
+}
+
+void handle_table_free(handle_table *table) {
+    VALIDATE_PTR(table);
+
+    vm_region_release(table->generations, sizeof(uint32_t) * table->capacity);
+    vm_region_release(table->dense_index, sizeof(uint32_t) * table->capacity);
+    vm_region_release(table->types, sizeof(object_type) * table->capacity);
+    vm_region_release(table->in_use, sizeof(bool) * table->capacity);
+    vm_region_release(table->free_slots, sizeof(uint32_t) * table->capacity);
+
+    *table = (handle_table){0};
+}
+
+int handle_table_acquire(handle_table *table, const object_type type, const size_t index) {
+    VALIDATE_PTR_RET(table, INVALID_HANDLE);
+
+    uint32_t slot;
+    if (table->free_count > 0) {
+        table->free_count--;
+        slot = table->free_slots[table->free_count];
+    } else {
+        if (table->slot_count >= table->capacity) {
+            fprintf(stderr, "ERROR: Handle table exhausted (%zu slots)\n", table->capacity);
+            return INVALID_HANDLE;
+        }
+
+        slot = (uint32_t)table->slot_count;
+        table->generations[slot] = 0;
+        table->slot_count++;
+    }
+
+    table->dense_index[slot] = (uint32_t)index;
+    table->types[slot] = type;
+    table->in_use[slot] = true;
+
+    return make_handle(slot, table->generations[slot]);
+}
+
+void handle_table_release(handle_table *table, const int handle) {
+    if (table == nullptr || handle < 0) return;
+
+    const uint32_t slot = handle_slot(handle);
+    if (slot >= table->slot_count || !table->in_use[slot] ||
+        table->generations[slot] != handle_generation(handle)) {
+        return;
+    }
+
+    table->in_use[slot] = false;
+    table->generations[slot] = (table->generations[slot] + 1u) & HANDLE_GENERATION_MASK;
+    table->free_slots[table->free_count] = slot;
+    table->free_count++;
+}
+
+void handle_table_relocate(handle_table *table, const int handle, const size_t index) {
+    if (table == nullptr || handle < 0) return;
+
+    const uint32_t slot = handle_slot(handle);
+    if (slot < table->slot_count) {
+        table->dense_index[slot] = (uint32_t)index;
+    }
+}
+
+int handle_table_resolve(const handle_table *table, const int handle, const object_type type) {
+    if (table == nullptr || handle < 0) return -1;
+
+    const uint32_t slot = handle_slot(handle);
+    if (slot >= table->slot_count || !table->in_use[slot] ||
+        table->generations[slot] != handle_generation(handle) ||
+        table->types[slot] != type) {
+        return -1;
+    }
+
+    return (int)table->dense_index[slot];
+}
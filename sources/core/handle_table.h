@@ -0,0 +1,44 @@
+#ifndef PROJEKT_HANDLE_TABLE_H
+#define PROJEKT_HANDLE_TABLE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <assert.h>
+
+#include "game_object.h"
+
+// Object ids are handles: the low bits select a slot, the high bits hold the
+// slot's generation. Releasing a slot bumps its generation, so ids held by
+// towers and projectiles go stale instead of aliasing a newer object.
+#define HANDLE_INDEX_BITS 20
+#define HANDLE_GENERATION_BITS 11
+#define HANDLE_MAX_SLOTS (1u << HANDLE_INDEX_BITS)
+#define INVALID_HANDLE (-1)
+
+static_assert(HANDLE_INDEX_BITS + HANDLE_GENERATION_BITS < 32,
+              "Handles must fit in a non-negative int");
+
+typedef struct {
+    uint32_t *generations;
+    uint32_t *dense_index;
+    object_type *types;
+    bool *in_use;
+    uint32_t *free_slots;
+
+    size_t free_count;
+    size_t slot_count;
+    size_t capacity;
+} handle_table;
+
+static inline uint32_t handle_slot(const int handle) {
+    return (uint32_t)handle & (HANDLE_MAX_SLOTS - 1u);
+}
+
+result_code handle_table_init(handle_table *table, size_t max_slots);
+void handle_table_free(handle_table *table);
+int handle_table_acquire(handle_table *table, object_type type, size_t index);
+void handle_table_release(handle_table *table, int handle);
+void handle_table_relocate(handle_table *table, int handle, size_t index);
+int handle_table_resolve(const handle_table *table, int handle, object_type type);
+
+#endif //PROJEKT_HANDLE_TABLE_H
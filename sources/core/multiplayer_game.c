@@ -7,6 +7,13 @@
 #include "tower.h"
 #include <stdio.h>
 
+static void send_wave_start(network_state* net, const int wave) {
+    typedef struct { uint8_t wave; } wave_start_data;
+    wave_start_data data = { .wave = (uint8_t)wave };
+    network_message wave_msg = network_create_message(msg_wave_start, &data, sizeof(data));
+    network_send(net, &wave_msg);
+}
+
 void run_multiplayer_host_game(network_state* net, int window_width, int window_height)
 {
     set_window_size(window_width, window_height);
@@ -14,6 +21,8 @@ void run_multiplayer_host_game(network_state* net, int window_width, int window_
     game local_game = init_game();
     game remote_game = init_game();
 
+    local_game.external_wave_end = true;
+    remote_game.external_wave_end = true;
     start_next_wave(&local_game);
     local_game.state = game_state_playing;
     start_next_wave(&remote_game);
@@ -25,25 +34,25 @@ void run_multiplayer_host_game(network_state* net, int window_width, int window_
     bool remote_wave_complete = false;
 
     float game_sync_timer = 0.0f;
+    sim_clock clock = {0};
+    hud_labels local_hud = {0};
+    hud_labels remote_hud = {0};
 
     while (!window_should_close() && network_is_connected(net)) {
         constexpr float game_sync_interval = 1.0f;
         const float delta = get_frame_time();
+        const int steps = sim_clock_advance(&clock, delta);
 
         const int current_width = get_screen_width();
         const int current_height = get_screen_height();
         update_multiplayer_ui_dimensions(&mp_ui, current_width, current_height);
 
         if (local_game.state == game_state_playing) {
-            if (local_game.player_lives <= 0) {
-                local_game.state = game_state_game_over;
-            }
-
             const grid_coord grid_pos = screen_to_grid(get_mouse_position(), &local_game.tilemap);
-            const game_object* hovered_tower = find_tower_at_grid(&local_game, grid_pos);
+            const int hovered_tower = find_tower_at_grid(&local_game, grid_pos);
             const int spot_index = find_tower_spot_at_grid(&local_game, grid_pos);
 
-            if (hovered_tower != nullptr || spot_index >= 0) {
+            if (hovered_tower >= 0 || spot_index >= 0) {
                 use_pointer_cursor();
             } else {
                 use_normal_cursor();
@@ -57,7 +66,7 @@ void run_multiplayer_host_game(network_state* net, int window_width, int window_
                         typedef struct { uint8_t spot; uint8_t level; } tower_upgrade_data;
                         tower_upgrade_data upgrade_data = {
                             .spot = (uint8_t)spot_index,
-                            .level = (uint8_t)(hovered_tower ? hovered_tower->data.tower.level : 0)
+                            .level = (uint8_t)(hovered_tower >= 0 ? local_game.towers.level[hovered_tower] : 0)
                         };
                         network_message msg = network_create_message(msg_tower_upgrade, &upgrade_data, sizeof(upgrade_data));
                         network_send(net, &msg);
@@ -81,76 +90,46 @@ void run_multiplayer_host_game(network_state* net, int window_width, int window_
                         break;
                 }
             }
+        }
 
-            const wave_config current_wave = get_wave_config(local_game.current_wave);
-            if (local_game.enemies_spawned_in_wave < current_wave.enemy_count) {
-                local_game.enemy_spawn_timer -= delta;
-                if (local_game.enemy_spawn_timer <= 0) {
-                    spawn_enemy(&local_game);
-                    local_game.enemy_spawn_timer = current_wave.spawn_interval;
-                }
-            }
-
-            const bool wave_spawning_complete = local_game.enemies_spawned_in_wave >= current_wave.enemy_count;
-            if (wave_spawning_complete && local_game.enemies_alive == 0 && !local_wave_complete) {
-                local_wave_complete = true;
-
-                // Notify opponent we're done
-                network_message msg = network_create_message(msg_wave_complete, nullptr, 0);
-                network_send(net, &msg);
-
-                // Check if both players are done
-                if (remote_wave_complete) {
-                    local_game.state = game_state_wave_break;
-                    local_game.wave_break_timer = WAVE_BREAK_DURATION;
-                }
-            }
-
-            update_game_state(&local_game, delta);
+        const int wave_before_ticks = local_game.current_wave;
+        for (int step = 0; step < steps; step++) {
+            simulate_tick(&local_game);
+            simulate_tick(&remote_game);
         }
+        local_game.render_alpha = clock.alpha;
+        remote_game.render_alpha = clock.alpha;
 
-        if (remote_game.state == game_state_playing) {
-            const wave_config remote_wave = get_wave_config(remote_game.current_wave);
-            if (remote_game.enemies_spawned_in_wave < remote_wave.enemy_count) {
-                remote_game.enemy_spawn_timer -= delta;
-                if (remote_game.enemy_spawn_timer <= 0) {
-                    spawn_enemy(&remote_game);
-                    remote_game.enemy_spawn_timer = remote_wave.spawn_interval;
-                }
-            }
+        if (local_game.state == game_state_playing && !local_wave_complete && is_wave_finished(&local_game)) {
+            local_wave_complete = true;
 
-            update_game_state(&remote_game, delta);
-        }
-        else if (remote_game.state == game_state_wave_break) {
-            update_game_state(&remote_game, delta);
-            remote_game.wave_break_timer -= delta;
-            if (remote_game.wave_break_timer <= 0) {
-                start_next_wave(&remote_game);
-                remote_game.state = game_state_playing;
+            // Notify opponent we're done
+            network_message msg = network_create_message(msg_wave_complete, nullptr, 0);
+            network_send(net, &msg);
+
+            // Check if both players are done
+            if (remote_wave_complete) {
+                local_game.state = game_state_wave_break;
+                local_game.wave_break_timer = WAVE_BREAK_DURATION;
             }
         }
 
         if (local_game.state == game_state_wave_break) {
             handle_playing_input(&local_game);
-            update_game_state(&local_game, delta);
 
-            local_game.wave_break_timer -= delta;
-            if (local_game.wave_break_timer <= 0 || is_key_pressed(key_space)) {
+            if (is_key_pressed(key_space)) {
                 start_next_wave(&local_game);
                 local_game.state = game_state_playing;
-
-                // Reset wave completion flags
-                local_wave_complete = false;
-                remote_wave_complete = false;
-
-                // Sync wave start with opponent
-                typedef struct { uint8_t wave; } wave_start_data;
-                wave_start_data data = { .wave = (uint8_t)local_game.current_wave };
-                network_message wave_msg = network_create_message(msg_wave_start, &data, sizeof(data));
-                network_send(net, &wave_msg);
             }
         }
 
+        // simulate_tick starts the next wave itself when the break runs out
+        if (local_game.current_wave != wave_before_ticks) {
+            local_wave_complete = false;
+            remote_wave_complete = false;
+            send_wave_start(net, local_game.current_wave);
+        }
+
         update_multiplayer_ui(&mp_ui);
 
         game_sync_timer += delta;
@@ -215,7 +194,7 @@ void run_multiplayer_host_game(network_state* net, int window_width, int window_
                     auto data = (const tower_build_data*)msg.data;
 
                     // Build tower in remote game
-                    if (data->spot < 4) {
+                    if (data->spot < TOWER_SPOT_COUNT) {
                         try_build_tower(&remote_game, data->spot);
                     }
                     break;
@@ -226,16 +205,16 @@ void run_multiplayer_host_game(network_state* net, int window_width, int window_
                     auto data = (const tower_upgrade_data*)msg.data;
 
                     // Find and upgrade tower in remote game
-                    if (data->spot < 4) {
+                    if (data->spot < TOWER_SPOT_COUNT) {
                         const tower_spot* spot = &remote_game.tower_spots[data->spot];
-                        game_object* tower_obj = find_tower_at_grid(&remote_game, (grid_coord){
+                        const int tower_index = find_tower_at_grid(&remote_game, (grid_coord){
                             .x = (int)spot->position.x,
                             .y = (int)spot->position.y
                         });
-                        if (tower_obj) {
+                        if (tower_index >= 0) {
                             upgrade_clicked_tower(&remote_game, (grid_coord){
-                                .x = (int)tower_obj->position.x,
-                                .y = (int)tower_obj->position.y
+                                .x = (int)remote_game.towers.pos_x[tower_index],
+                                .y = (int)remote_game.towers.pos_y[tower_index]
                             });
                         }
                     }
@@ -314,8 +293,8 @@ void run_multiplayer_host_game(network_state* net, int window_width, int window_
         draw_tilemap(&local_game.tilemap);
         draw_tower_spots(&local_game);
         draw_game_objects(&local_game);
-        draw_hud(&local_game);
-        draw_wave_info(&local_game);
+        draw_hud(&local_game, &local_hud);
+        draw_wave_info(&local_game, &local_hud);
 
         // Show waiting message when local is complete but remote isn't
         if (local_wave_complete && !remote_wave_complete) {
@@ -338,8 +317,8 @@ void run_multiplayer_host_game(network_state* net, int window_width, int window_
         draw_tilemap(&remote_game.tilemap);
         draw_tower_spots(&remote_game);
         draw_game_objects(&remote_game);
-        draw_hud(&remote_game);
-        draw_wave_info(&remote_game);
+        draw_hud(&remote_game, &remote_hud);
+        draw_wave_info(&remote_game, &remote_hud);
 
         reset_viewport();
 
@@ -354,8 +333,11 @@ void run_multiplayer_host_game(network_state* net, int window_width, int window_
         }
     }
 
+    unload_hud(&local_hud);
+    unload_hud(&remote_hud);
     unload_game(&local_game);
     unload_game(&remote_game);
+    unload_multiplayer_ui(&mp_ui);
 }
 
 void run_multiplayer_client_game(network_state* net, int window_width, int window_height)
@@ -365,6 +347,8 @@ void run_multiplayer_client_game(network_state* net, int window_width, int windo
     game local_game = init_game();
     game remote_game = init_game();
 
+    local_game.external_wave_end = true;
+    remote_game.external_wave_end = true;
     start_next_wave(&local_game);
     local_game.state = game_state_playing;
     start_next_wave(&remote_game);
@@ -376,25 +360,25 @@ void run_multiplayer_client_game(network_state* net, int window_width, int windo
     bool remote_wave_complete = false;
 
     float game_sync_timer = 0.0f;
+    sim_clock clock = {0};
+    hud_labels local_hud = {0};
+    hud_labels remote_hud = {0};
 
     while (!window_should_close() && network_is_connected(net)) {
         constexpr float game_sync_interval = 1.0f;
         const float delta = get_frame_time();
+        const int steps = sim_clock_advance(&clock, delta);
 
         const int current_width = get_screen_width();
         const int current_height = get_screen_height();
         update_multiplayer_ui_dimensions(&mp_ui, current_width, current_height);
 
         if (local_game.state == game_state_playing) {
-            if (local_game.player_lives <= 0) {
-                local_game.state = game_state_game_over;
-            }
-
             const grid_coord grid_pos = screen_to_grid(get_mouse_position(), &local_game.tilemap);
-            const game_object* hovered_tower = find_tower_at_grid(&local_game, grid_pos);
+            const int hovered_tower = find_tower_at_grid(&local_game, grid_pos);
             const int spot_index = find_tower_spot_at_grid(&local_game, grid_pos);
 
-            if (hovered_tower != nullptr || spot_index >= 0) {
+            if (hovered_tower >= 0 || spot_index >= 0) {
                 use_pointer_cursor();
             } else {
                 use_normal_cursor();
@@ -408,7 +392,7 @@ void run_multiplayer_client_game(network_state* net, int window_width, int windo
                         typedef struct { uint8_t spot; uint8_t level; } tower_upgrade_data;
                         tower_upgrade_data upgrade_data = {
                             .spot = (uint8_t)spot_index,
-                            .level = (uint8_t)(hovered_tower ? hovered_tower->data.tower.level : 0)
+                            .level = (uint8_t)(hovered_tower >= 0 ? local_game.towers.level[hovered_tower] : 0)
                         };
                         network_message msg = network_create_message(msg_tower_upgrade, &upgrade_data, sizeof(upgrade_data));
                         network_send(net, &msg);
@@ -432,76 +416,46 @@ void run_multiplayer_client_game(network_state* net, int window_width, int windo
                         break;
                 }
             }
+        }
 
-            const wave_config current_wave = get_wave_config(local_game.current_wave);
-            if (local_game.enemies_spawned_in_wave < current_wave.enemy_count) {
-                local_game.enemy_spawn_timer -= delta;
-                if (local_game.enemy_spawn_timer <= 0) {
-                    spawn_enemy(&local_game);
-                    local_game.enemy_spawn_timer = current_wave.spawn_interval;
-                }
-            }
-
-            const bool wave_spawning_complete = local_game.enemies_spawned_in_wave >= current_wave.enemy_count;
-            if (wave_spawning_complete && local_game.enemies_alive == 0 && !local_wave_complete) {
-                local_wave_complete = true;
-
-                // Notify opponent we're done
-                network_message msg = network_create_message(msg_wave_complete, nullptr, 0);
-                network_send(net, &msg);
-
-                // Check if both players are done
-                if (remote_wave_complete) {
-                    local_game.state = game_state_wave_break;
-                    local_game.wave_break_timer = WAVE_BREAK_DURATION;
-                }
-            }
-
-            update_game_state(&local_game, delta);
+        const int wave_before_ticks = local_game.current_wave;
+        for (int step = 0; step < steps; step++) {
+            simulate_tick(&local_game);
+            simulate_tick(&remote_game);
         }
+        local_game.render_alpha = clock.alpha;
+        remote_game.render_alpha = clock.alpha;
 
-        if (remote_game.state == game_state_playing) {
-            const wave_config remote_wave = get_wave_config(remote_game.current_wave);
-            if (remote_game.enemies_spawned_in_wave < remote_wave.enemy_count) {
-                remote_game.enemy_spawn_timer -= delta;
-                if (remote_game.enemy_spawn_timer <= 0) {
-                    spawn_enemy(&remote_game);
-                    remote_game.enemy_spawn_timer = remote_wave.spawn_interval;
-                }
-            }
+        if (local_game.state == game_state_playing && !local_wave_complete && is_wave_finished(&local_game)) {
+            local_wave_complete = true;
 
-            update_game_state(&remote_game, delta);
-        }
-        else if (remote_game.state == game_state_wave_break) {
-            update_game_state(&remote_game, delta);
-            remote_game.wave_break_timer -= delta;
-            if (remote_game.wave_break_timer <= 0) {
-                start_next_wave(&remote_game);
-                remote_game.state = game_state_playing;
+            // Notify opponent we're done
+            network_message msg = network_create_message(msg_wave_complete, nullptr, 0);
+            network_send(net, &msg);
+
+            // Check if both players are done
+            if (remote_wave_complete) {
+                local_game.state = game_state_wave_break;
+                local_game.wave_break_timer = WAVE_BREAK_DURATION;
             }
         }
 
         if (local_game.state == game_state_wave_break) {
             handle_playing_input(&local_game);
-            update_game_state(&local_game, delta);
 
-            local_game.wave_break_timer -= delta;
-            if (local_game.wave_break_timer <= 0 || is_key_pressed(key_space)) {
+            if (is_key_pressed(key_space)) {
                 start_next_wave(&local_game);
                 local_game.state = game_state_playing;
-
-                // Reset wave completion flags
-                local_wave_complete = false;
-                remote_wave_complete = false;
-
-                // Sync wave start with opponent
-                typedef struct { uint8_t wave; } wave_start_data;
-                wave_start_data data = { .wave = (uint8_t)local_game.current_wave };
-                network_message wave_msg = network_create_message(msg_wave_start, &data, sizeof(data));
-                network_send(net, &wave_msg);
             }
         }
 
+        // simulate_tick starts the next wave itself when the break runs out
+        if (local_game.current_wave != wave_before_ticks) {
+            local_wave_complete = false;
+            remote_wave_complete = false;
+            send_wave_start(net, local_game.current_wave);
+        }
+
         update_multiplayer_ui(&mp_ui);
 
         game_sync_timer += delta;
@@ -566,7 +520,7 @@ void run_multiplayer_client_game(network_state* net, int window_width, int windo
                     auto data = (const tower_build_data*)msg.data;
 
                     // Build tower in remote game
-                    if (data->spot < 4) {
+                    if (data->spot < TOWER_SPOT_COUNT) {
                         try_build_tower(&remote_game, data->spot);
                     }
                     break;
@@ -577,16 +531,16 @@ void run_multiplayer_client_game(network_state* net, int window_width, int windo
                     auto data = (const tower_upgrade_data*)msg.data;
 
                     // Find and upgrade tower in remote game
-                    if (data->spot < 4) {
+                    if (data->spot < TOWER_SPOT_COUNT) {
                         const tower_spot* spot = &remote_game.tower_spots[data->spot];
-                        game_object* tower_obj = find_tower_at_grid(&remote_game, (grid_coord){
+                        const int tower_index = find_tower_at_grid(&remote_game, (grid_coord){
                             .x = (int)spot->position.x,
                             .y = (int)spot->position.y
                         });
-                        if (tower_obj) {
+                        if (tower_index >= 0) {
                             upgrade_clicked_tower(&remote_game, (grid_coord){
-                                .x = (int)tower_obj->position.x,
-                                .y = (int)tower_obj->position.y
+                                .x = (int)remote_game.towers.pos_x[tower_index],
+                                .y = (int)remote_game.towers.pos_y[tower_index]
                             });
                         }
                     }
@@ -665,8 +619,8 @@ void run_multiplayer_client_game(network_state* net, int window_width, int windo
         draw_tilemap(&local_game.tilemap);
         draw_tower_spots(&local_game);
         draw_game_objects(&local_game);
-        draw_hud(&local_game);
-        draw_wave_info(&local_game);
+        draw_hud(&local_game, &local_hud);
+        draw_wave_info(&local_game, &local_hud);
 
         // Show waiting message when local is complete but remote isn't
         if (local_wave_complete && !remote_wave_complete) {
@@ -689,8 +643,8 @@ void run_multiplayer_client_game(network_state* net, int window_width, int windo
         draw_tilemap(&remote_game.tilemap);
         draw_tower_spots(&remote_game);
         draw_game_objects(&remote_game);
-        draw_hud(&remote_game);
-        draw_wave_info(&remote_game);
+        draw_hud(&remote_game, &remote_hud);
+        draw_wave_info(&remote_game, &remote_hud);
 
         reset_viewport();
 
@@ -705,6 +659,9 @@ void run_multiplayer_client_game(network_state* net, int window_width, int windo
         }
     }
 
+    unload_hud(&local_hud);
+    unload_hud(&remote_hud);
     unload_game(&local_game);
     unload_game(&remote_game);
+    unload_multiplayer_ui(&mp_ui);
 }
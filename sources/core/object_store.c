@@ -0,0 +1,816 @@
+#include "object_store.h"
+#include "game.h"
+#include "vm_region.h"
+
+#include <stdio.h>
+#include <string.h>
+
+// Every column is reserved up front for max_capacity rows, so growing a store
+// never copies it and row pointers stay valid; capacity only tracks how much
+// of the reservation is in use.
+#define RESERVE_FIELD(store, field)                                                   \
+    do {                                                                              \
+        (store)->field = vm_region_reserve(sizeof(*(store)->field) * (store)->max_capacity); \
+        if ((store)->field == nullptr) return result_error_out_of_memory;             \
+    } while (0)
+
+#define DISCARD_FIELD(store, field, new_capacity)                                     \
+    vm_region_discard((store)->field, sizeof(*(store)->field) * (new_capacity),       \
+                      sizeof(*(store)->field) * (store)->max_capacity)
+
+#define RELEASE_FIELD(store, field) \
+    vm_region_release((store)->field, sizeof(*(store)->field) * (store)->max_capacity)
+
+static size_t next_capacity(const size_t capacity, const size_t max_capacity) {
+    const size_t grown = capacity == 0 ? STARTING_COUNT_OF_GAME_OBJECTS : capacity * 2;
+    return grown < max_capacity ? grown : max_capacity;
+}
+
+// Stores grow when full but only shrink once they are nearly empty, so a
+// population that swings every wave does not bounce between sizes.
+static bool should_shrink(const size_t count, const size_t capacity) {
+    return capacity > (size_t)STARTING_COUNT_OF_GAME_OBJECTS * 2 && count < capacity / STORE_SHRINK_DIVISOR;
+}
+
+// Compacting once tombstones make up a fixed share of the store keeps the
+// cost amortized to a constant number of moved rows per removal.
+static bool is_fragmented(const size_t free_count, const size_t count) {
+    if (free_count == 0 || free_count == count) return false;
+    return free_count >= STORE_MIN_COMPACT_ROWS && free_count * STORE_FRAGMENTATION_DIVISOR >= count;
+}
+
+#define ROW_BYTES(store, field) sizeof(*(store)->field)
+
+static size_t enemy_row_size(const enemy_store *store) {
+    return ROW_BYTES(store, ids) + ROW_BYTES(store, pos_x) + ROW_BYTES(store, pos_y) +
+           ROW_BYTES(store, prev_x) + ROW_BYTES(store, prev_y) + ROW_BYTES(store, health) +
+           ROW_BYTES(store, max_health) + ROW_BYTES(store, speed) + ROW_BYTES(store, distance) +
+           ROW_BYTES(store, waypoint_index) + ROW_BYTES(store, path_id) + ROW_BYTES(store, gold_reward) +
+           ROW_BYTES(store, type) + ROW_BYTES(store, anim_state) + ROW_BYTES(store, current_frame) +
+           ROW_BYTES(store, frame_timer) + ROW_BYTES(store, spawn_tick) + ROW_BYTES(store, hit_tick) +
+           ROW_BYTES(store, is_active);
+}
+
+static size_t tower_row_size(const tower_store *store) {
+    return ROW_BYTES(store, ids) + ROW_BYTES(store, pos_x) + ROW_BYTES(store, pos_y) +
+           ROW_BYTES(store, damage) + ROW_BYTES(store, range) + ROW_BYTES(store, fire_cooldown) +
+           ROW_BYTES(store, target_id) + ROW_BYTES(store, width) + ROW_BYTES(store, height) +
+           ROW_BYTES(store, upgrade_cost) + ROW_BYTES(store, level) + ROW_BYTES(store, fire_mode) +
+           ROW_BYTES(store, target_policy) + ROW_BYTES(store, is_active);
+}
+
+static size_t projectile_row_size(const projectile_store *store) {
+    return ROW_BYTES(store, ids) + ROW_BYTES(store, pos_x) + ROW_BYTES(store, pos_y) +
+           ROW_BYTES(store, prev_x) + ROW_BYTES(store, prev_y) + ROW_BYTES(store, vel_x) +
+           ROW_BYTES(store, vel_y) + ROW_BYTES(store, damage) + ROW_BYTES(store, owner_id) +
+           ROW_BYTES(store, target_id) + ROW_BYTES(store, current_frame) + ROW_BYTES(store, frame_timer) +
+           ROW_BYTES(store, row) + ROW_BYTES(store, is_active);
+}
+
+result_code enemy_store_reserve(enemy_store *store, const size_t capacity) {
+    VALIDATE_PTR_RET(store, result_error_null_ptr);
+
+    if (capacity < store->count) {
+        return result_error_out_of_bounds;
+    }
+    if (capacity > store->max_capacity) {
+        return result_error_out_of_memory;
+    }
+
+    if (capacity < store->capacity) {
+        DISCARD_FIELD(store, ids, capacity);
+        DISCARD_FIELD(store, pos_x, capacity);
+        DISCARD_FIELD(store, pos_y, capacity);
+        DISCARD_FIELD(store, prev_x, capacity);
+        DISCARD_FIELD(store, prev_y, capacity);
+        DISCARD_FIELD(store, health, capacity);
+        DISCARD_FIELD(store, max_health, capacity);
+        DISCARD_FIELD(store, speed, capacity);
+        DISCARD_FIELD(store, distance, capacity);
+        DISCARD_FIELD(store, waypoint_index, capacity);
+        DISCARD_FIELD(store, path_id, capacity);
+        DISCARD_FIELD(store, gold_reward, capacity);
+        DISCARD_FIELD(store, type, capacity);
+        DISCARD_FIELD(store, anim_state, capacity);
+        DISCARD_FIELD(store, current_frame, capacity);
+        DISCARD_FIELD(store, frame_timer, capacity);
+        DISCARD_FIELD(store, spawn_tick, capacity);
+        DISCARD_FIELD(store, hit_tick, capacity);
+        DISCARD_FIELD(store, is_active, capacity);
+        DISCARD_FIELD(store, free_slots, capacity);
+        DISCARD_FIELD(store, retired, capacity);
+    }
+
+    if (capacity != store->capacity) {
+        store->stats.resizes++;
+    }
+    store->capacity = capacity;
+    return result_ok;
+}
+
+result_code enemy_store_init(enemy_store *store, const size_t capacity, const size_t max_capacity) {
+    VALIDATE_PTR_RET(store, result_error_null_ptr);
+
+    *store = (enemy_store){0};
+    store->max_capacity = max_capacity;
+
+    RESERVE_FIELD(store, ids);
+    RESERVE_FIELD(store, pos_x);
+    RESERVE_FIELD(store, pos_y);
+    RESERVE_FIELD(store, prev_x);
+    RESERVE_FIELD(store, prev_y);
+    RESERVE_FIELD(store, health);
+    RESERVE_FIELD(store, max_health);
+    RESERVE_FIELD(store, speed);
+    RESERVE_FIELD(store, distance);
+    RESERVE_FIELD(store, waypoint_index);
+    RESERVE_FIELD(store, path_id);
+    RESERVE_FIELD(store, gold_reward);
+    RESERVE_FIELD(store, type);
+    RESERVE_FIELD(store, anim_state);
+    RESERVE_FIELD(store, current_frame);
+    RESERVE_FIELD(store, frame_timer);
+    RESERVE_FIELD(store, spawn_tick);
+    RESERVE_FIELD(store, hit_tick);
+    RESERVE_FIELD(store, is_active);
+    RESERVE_FIELD(store, free_slots);
+    RESERVE_FIELD(store, retired);
+
+    return enemy_store_reserve(store, capacity);
+}
+
+void enemy_store_free(enemy_store *store) {
+    VALIDATE_PTR(store);
+
+    RELEASE_FIELD(store, ids);
+    RELEASE_FIELD(store, pos_x);
+    RELEASE_FIELD(store, pos_y);
+    RELEASE_FIELD(store, prev_x);
+    RELEASE_FIELD(store, prev_y);
+    RELEASE_FIELD(store, health);
+    RELEASE_FIELD(store, max_health);
+    RELEASE_FIELD(store, speed);
+    RELEASE_FIELD(store, distance);
+    RELEASE_FIELD(store, waypoint_index);
+    RELEASE_FIELD(store, path_id);
+    RELEASE_FIELD(store, gold_reward);
+    RELEASE_FIELD(store, type);
+    RELEASE_FIELD(store, anim_state);
+    RELEASE_FIELD(store, current_frame);
+    RELEASE_FIELD(store, frame_timer);
+    RELEASE_FIELD(store, spawn_tick);
+    RELEASE_FIELD(store, hit_tick);
+    RELEASE_FIELD(store, is_active);
+    RELEASE_FIELD(store, free_slots);
+    RELEASE_FIELD(store, retired);
+
+    *store = (enemy_store){0};
+}
+
+result_code enemy_store_push(enemy_store *store, const game_object *obj) {
+    VALIDATE_PTR_RET(store, result_error_null_ptr);
+    VALIDATE_PTR_RET(obj, result_error_null_ptr);
+
+    size_t i;
+    if (store->free_count > 0) {
+        i = store->free_slots[--store->free_count];
+    }
+    else {
+        if (store->count == store->max_capacity) {
+            return result_error_out_of_memory;
+        }
+        if (store->count == store->capacity) {
+            const result_code res = enemy_store_reserve(store, next_capacity(store->capacity, store->max_capacity));
+            if (res != result_ok) {
+                return res;
+            }
+        }
+        i = store->count++;
+    }
+
+    const enemy_data *data = &obj->data.enemy;
+
+    store->ids[i] = obj->id;
+    store->pos_x[i] = obj->position.x;
+    store->pos_y[i] = obj->position.y;
+    store->prev_x[i] = obj->position.x;
+    store->prev_y[i] = obj->position.y;
+    store->health[i] = data->health;
+    store->max_health[i] = data->max_health;
+    store->speed[i] = data->speed;
+    store->distance[i] = data->distance;
+    store->waypoint_index[i] = data->waypoint_index;
+    store->path_id[i] = data->path_id;
+    store->gold_reward[i] = data->gold_reward;
+    store->type[i] = data->type;
+    store->anim_state[i] = data->anim_state;
+    store->current_frame[i] = data->current_frame;
+    store->frame_timer[i] = data->frame_timer;
+    store->spawn_tick[i] = data->spawn_tick;
+    store->hit_tick[i] = data->hit_tick;
+    store->is_active[i] = obj->is_active;
+
+    return result_ok;
+}
+
+game_object enemy_store_get(const enemy_store *store, const size_t index) {
+    return (game_object) {
+        .id = store->ids[index],
+        .type = enemy,
+        .position = {store->pos_x[index], store->pos_y[index]},
+        .is_active = store->is_active[index],
+        .data.enemy = {
+            .health = store->health[index],
+            .max_health = store->max_health[index],
+            .speed = store->speed[index],
+            .distance = store->distance[index],
+            .waypoint_index = store->waypoint_index[index],
+            .path_id = store->path_id[index],
+            .gold_reward = store->gold_reward[index],
+            .type = store->type[index],
+            .anim_state = store->anim_state[index],
+            .current_frame = store->current_frame[index],
+            .frame_timer = store->frame_timer[index],
+            .spawn_tick = store->spawn_tick[index],
+            .hit_tick = store->hit_tick[index]
+        }
+    };
+}
+
+static void enemy_store_move(enemy_store *store, const size_t dst, const size_t src) {
+    store->stats.bytes_moved += enemy_row_size(store);
+    store->ids[dst] = store->ids[src];
+    store->pos_x[dst] = store->pos_x[src];
+    store->pos_y[dst] = store->pos_y[src];
+    store->prev_x[dst] = store->prev_x[src];
+    store->prev_y[dst] = store->prev_y[src];
+    store->health[dst] = store->health[src];
+    store->max_health[dst] = store->max_health[src];
+    store->speed[dst] = store->speed[src];
+    store->distance[dst] = store->distance[src];
+    store->waypoint_index[dst] = store->waypoint_index[src];
+    store->path_id[dst] = store->path_id[src];
+    store->gold_reward[dst] = store->gold_reward[src];
+    store->type[dst] = store->type[src];
+    store->anim_state[dst] = store->anim_state[src];
+    store->current_frame[dst] = store->current_frame[src];
+    store->frame_timer[dst] = store->frame_timer[src];
+    store->spawn_tick[dst] = store->spawn_tick[src];
+    store->hit_tick[dst] = store->hit_tick[src];
+    store->is_active[dst] = store->is_active[src];
+}
+
+size_t enemy_store_next_slot(const enemy_store *store) {
+    return store->free_count > 0 ? store->free_slots[store->free_count - 1] : store->count;
+}
+
+void enemy_store_release(enemy_store *store, const size_t index, handle_table *handles) {
+    VALIDATE_PTR(store);
+
+    if (store->ids[index] == INVALID_HANDLE) {
+        return;
+    }
+
+    handle_table_release(handles, store->ids[index]);
+    store->ids[index] = INVALID_HANDLE;
+    store->is_active[index] = false;
+    store->free_slots[store->free_count++] = (uint32_t)index;
+}
+
+// Marks a row that left play on its own; the caller releases retired rows
+// at the end of the tick without scanning the store for them
+void enemy_store_retire(enemy_store *store, const size_t index) {
+    VALIDATE_PTR(store);
+
+    if (!store->is_active[index]) {
+        return;
+    }
+    store->is_active[index] = false;
+    store->retired[store->retired_count++] = (uint32_t)index;
+}
+
+void enemy_store_compact(enemy_store *store, handle_table *handles) {
+    VALIDATE_PTR(store);
+
+    size_t write_index = 0;
+    for (size_t read_index = 0; read_index < store->count; read_index++) {
+        if (!store->is_active[read_index]) {
+            if (store->ids[read_index] != INVALID_HANDLE) {
+                handle_table_release(handles, store->ids[read_index]);
+            }
+            continue;
+        }
+        if (write_index != read_index) {
+            enemy_store_move(store, write_index, read_index);
+            handle_table_relocate(handles, store->ids[write_index], write_index);
+        }
+        write_index++;
+    }
+    store->count = write_index;
+    store->free_count = 0;
+    store->retired_count = 0;
+    store->stats.compactions++;
+
+    if (should_shrink(store->count, store->capacity) &&
+        enemy_store_reserve(store, store->capacity / 2) != result_ok) {
+        fprintf(stderr, "WARNING: Failed to compact enemy store\n");
+    }
+}
+
+void enemy_store_maintain(enemy_store *store, handle_table *handles) {
+    VALIDATE_PTR(store);
+
+    // A store of nothing but released rows has nothing to move
+    if (store->free_count > 0 && store->free_count == store->count) {
+        store->count = 0;
+        store->free_count = 0;
+        if (should_shrink(0, store->capacity) &&
+            enemy_store_reserve(store, store->capacity / 2) != result_ok) {
+            fprintf(stderr, "WARNING: Failed to shrink enemy store\n");
+        }
+        return;
+    }
+
+    if (is_fragmented(store->free_count, store->count)) {
+        enemy_store_compact(store, handles);
+    }
+}
+
+void enemy_store_save_positions(enemy_store *store) {
+    VALIDATE_PTR(store);
+
+    if (store->count == 0) return;
+    memcpy(store->prev_x, store->pos_x, sizeof(*store->pos_x) * store->count);
+    memcpy(store->prev_y, store->pos_y, sizeof(*store->pos_y) * store->count);
+}
+
+result_code tower_store_reserve(tower_store *store, const size_t capacity) {
+    VALIDATE_PTR_RET(store, result_error_null_ptr);
+
+    if (capacity < store->count) {
+        return result_error_out_of_bounds;
+    }
+    if (capacity > store->max_capacity) {
+        return result_error_out_of_memory;
+    }
+
+    if (capacity < store->capacity) {
+        DISCARD_FIELD(store, ids, capacity);
+        DISCARD_FIELD(store, pos_x, capacity);
+        DISCARD_FIELD(store, pos_y, capacity);
+        DISCARD_FIELD(store, damage, capacity);
+        DISCARD_FIELD(store, range, capacity);
+        DISCARD_FIELD(store, fire_cooldown, capacity);
+        DISCARD_FIELD(store, target_id, capacity);
+        DISCARD_FIELD(store, width, capacity);
+        DISCARD_FIELD(store, height, capacity);
+        DISCARD_FIELD(store, upgrade_cost, capacity);
+        DISCARD_FIELD(store, level, capacity);
+        DISCARD_FIELD(store, fire_mode, capacity);
+        DISCARD_FIELD(store, target_policy, capacity);
+        DISCARD_FIELD(store, is_active, capacity);
+        DISCARD_FIELD(store, free_slots, capacity);
+    }
+
+    if (capacity != store->capacity) {
+        store->stats.resizes++;
+    }
+    store->capacity = capacity;
+    return result_ok;
+}
+
+result_code tower_store_init(tower_store *store, const size_t capacity, const size_t max_capacity) {
+    VALIDATE_PTR_RET(store, result_error_null_ptr);
+
+    *store = (tower_store){0};
+    store->max_capacity = max_capacity;
+
+    RESERVE_FIELD(store, ids);
+    RESERVE_FIELD(store, pos_x);
+    RESERVE_FIELD(store, pos_y);
+    RESERVE_FIELD(store, damage);
+    RESERVE_FIELD(store, range);
+    RESERVE_FIELD(store, fire_cooldown);
+    RESERVE_FIELD(store, target_id);
+    RESERVE_FIELD(store, width);
+    RESERVE_FIELD(store, height);
+    RESERVE_FIELD(store, upgrade_cost);
+    RESERVE_FIELD(store, level);
+    RESERVE_FIELD(store, fire_mode);
+    RESERVE_FIELD(store, target_policy);
+    RESERVE_FIELD(store, is_active);
+    RESERVE_FIELD(store, free_slots);
+
+    return tower_store_reserve(store, capacity);
+}
+
+void tower_store_free(tower_store *store) {
+    VALIDATE_PTR(store);
+
+    RELEASE_FIELD(store, ids);
+    RELEASE_FIELD(store, pos_x);
+    RELEASE_FIELD(store, pos_y);
+    RELEASE_FIELD(store, damage);
+    RELEASE_FIELD(store, range);
+    RELEASE_FIELD(store, fire_cooldown);
+    RELEASE_FIELD(store, target_id);
+    RELEASE_FIELD(store, width);
+    RELEASE_FIELD(store, height);
+    RELEASE_FIELD(store, upgrade_cost);
+    RELEASE_FIELD(store, level);
+    RELEASE_FIELD(store, fire_mode);
+    RELEASE_FIELD(store, target_policy);
+    RELEASE_FIELD(store, is_active);
+    RELEASE_FIELD(store, free_slots);
+
+    *store = (tower_store){0};
+}
+
+result_code tower_store_push(tower_store *store, const game_object *obj) {
+    VALIDATE_PTR_RET(store, result_error_null_ptr);
+    VALIDATE_PTR_RET(obj, result_error_null_ptr);
+
+    size_t i;
+    if (store->free_count > 0) {
+        i = store->free_slots[--store->free_count];
+    }
+    else {
+        if (store->count == store->max_capacity) {
+            return result_error_out_of_memory;
+        }
+        if (store->count == store->capacity) {
+            const result_code res = tower_store_reserve(store, next_capacity(store->capacity, store->max_capacity));
+            if (res != result_ok) {
+                return res;
+            }
+        }
+        i = store->count++;
+    }
+
+    const tower_data *data = &obj->data.tower;
+
+    store->ids[i] = obj->id;
+    store->pos_x[i] = obj->position.x;
+    store->pos_y[i] = obj->position.y;
+    store->damage[i] = data->damage;
+    store->range[i] = data->range;
+    store->fire_cooldown[i] = data->fire_cooldown;
+    store->target_id[i] = data->target_id;
+    store->width[i] = data->width;
+    store->height[i] = data->height;
+    store->upgrade_cost[i] = data->upgrade_cost;
+    store->level[i] = data->level;
+    store->fire_mode[i] = data->fire_mode;
+    store->target_policy[i] = data->target_policy;
+    store->is_active[i] = obj->is_active;
+
+    return result_ok;
+}
+
+game_object tower_store_get(const tower_store *store, const size_t index) {
+    return (game_object) {
+        .id = store->ids[index],
+        .type = tower,
+        .position = {store->pos_x[index], store->pos_y[index]},
+        .is_active = store->is_active[index],
+        .data.tower = {
+            .damage = store->damage[index],
+            .range = store->range[index],
+            .fire_cooldown = store->fire_cooldown[index],
+            .target_id = store->target_id[index],
+            .width = store->width[index],
+            .height = store->height[index],
+            .upgrade_cost = store->upgrade_cost[index],
+            .level = store->level[index],
+            .fire_mode = store->fire_mode[index],
+            .target_policy = store->target_policy[index]
+        }
+    };
+}
+
+static void tower_store_move(tower_store *store, const size_t dst, const size_t src) {
+    store->stats.bytes_moved += tower_row_size(store);
+    store->ids[dst] = store->ids[src];
+    store->pos_x[dst] = store->pos_x[src];
+    store->pos_y[dst] = store->pos_y[src];
+    store->damage[dst] = store->damage[src];
+    store->range[dst] = store->range[src];
+    store->fire_cooldown[dst] = store->fire_cooldown[src];
+    store->target_id[dst] = store->target_id[src];
+    store->width[dst] = store->width[src];
+    store->height[dst] = store->height[src];
+    store->upgrade_cost[dst] = store->upgrade_cost[src];
+    store->level[dst] = store->level[src];
+    store->fire_mode[dst] = store->fire_mode[src];
+    store->target_policy[dst] = store->target_policy[src];
+    store->is_active[dst] = store->is_active[src];
+}
+
+size_t tower_store_next_slot(const tower_store *store) {
+    return store->free_count > 0 ? store->free_slots[store->free_count - 1] : store->count;
+}
+
+void tower_store_release(tower_store *store, const size_t index, handle_table *handles) {
+    VALIDATE_PTR(store);
+
+    if (store->ids[index] == INVALID_HANDLE) {
+        return;
+    }
+
+    handle_table_release(handles, store->ids[index]);
+    store->ids[index] = INVALID_HANDLE;
+    store->is_active[index] = false;
+    store->free_slots[store->free_count++] = (uint32_t)index;
+}
+
+void tower_store_compact(tower_store *store, handle_table *handles) {
+    VALIDATE_PTR(store);
+
+    size_t write_index = 0;
+    for (size_t read_index = 0; read_index < store->count; read_index++) {
+        if (!store->is_active[read_index]) {
+            if (store->ids[read_index] != INVALID_HANDLE) {
+                handle_table_release(handles, store->ids[read_index]);
+            }
+            continue;
+        }
+        if (write_index != read_index) {
+            tower_store_move(store, write_index, read_index);
+            handle_table_relocate(handles, store->ids[write_index], write_index);
+        }
+        write_index++;
+    }
+    store->count = write_index;
+    store->free_count = 0;
+    store->stats.compactions++;
+
+    if (should_shrink(store->count, store->capacity) &&
+        tower_store_reserve(store, store->capacity / 2) != result_ok) {
+        fprintf(stderr, "WARNING: Failed to compact tower store\n");
+    }
+}
+
+void tower_store_maintain(tower_store *store, handle_table *handles) {
+    VALIDATE_PTR(store);
+
+    // A store of nothing but released rows has nothing to move
+    if (store->free_count > 0 && store->free_count == store->count) {
+        store->count = 0;
+        store->free_count = 0;
+        if (should_shrink(0, store->capacity) &&
+            tower_store_reserve(store, store->capacity / 2) != result_ok) {
+            fprintf(stderr, "WARNING: Failed to shrink tower store\n");
+        }
+        return;
+    }
+
+    if (is_fragmented(store->free_count, store->count)) {
+        tower_store_compact(store, handles);
+    }
+}
+
+result_code projectile_store_reserve(projectile_store *store, const size_t capacity) {
+    VALIDATE_PTR_RET(store, result_error_null_ptr);
+
+    if (capacity < store->count) {
+        return result_error_out_of_bounds;
+    }
+    if (capacity > store->max_capacity) {
+        return result_error_out_of_memory;
+    }
+
+    if (capacity < store->capacity) {
+        DISCARD_FIELD(store, ids, capacity);
+        DISCARD_FIELD(store, pos_x, capacity);
+        DISCARD_FIELD(store, pos_y, capacity);
+        DISCARD_FIELD(store, prev_x, capacity);
+        DISCARD_FIELD(store, prev_y, capacity);
+        DISCARD_FIELD(store, vel_x, capacity);
+        DISCARD_FIELD(store, vel_y, capacity);
+        DISCARD_FIELD(store, damage, capacity);
+        DISCARD_FIELD(store, owner_id, capacity);
+        DISCARD_FIELD(store, target_id, capacity);
+        DISCARD_FIELD(store, current_frame, capacity);
+        DISCARD_FIELD(store, frame_timer, capacity);
+        DISCARD_FIELD(store, row, capacity);
+        DISCARD_FIELD(store, is_active, capacity);
+        DISCARD_FIELD(store, free_slots, capacity);
+        DISCARD_FIELD(store, retired, capacity);
+    }
+
+    if (capacity != store->capacity) {
+        store->stats.resizes++;
+    }
+    store->capacity = capacity;
+    return result_ok;
+}
+
+result_code projectile_store_init(projectile_store *store, const size_t capacity, const size_t max_capacity) {
+    VALIDATE_PTR_RET(store, result_error_null_ptr);
+
+    *store = (projectile_store){0};
+    store->max_capacity = max_capacity;
+
+    RESERVE_FIELD(store, ids);
+    RESERVE_FIELD(store, pos_x);
+    RESERVE_FIELD(store, pos_y);
+    RESERVE_FIELD(store, prev_x);
+    RESERVE_FIELD(store, prev_y);
+    RESERVE_FIELD(store, vel_x);
+    RESERVE_FIELD(store, vel_y);
+    RESERVE_FIELD(store, damage);
+    RESERVE_FIELD(store, owner_id);
+    RESERVE_FIELD(store, target_id);
+    RESERVE_FIELD(store, current_frame);
+    RESERVE_FIELD(store, frame_timer);
+    RESERVE_FIELD(store, row);
+    RESERVE_FIELD(store, is_active);
+    RESERVE_FIELD(store, free_slots);
+    RESERVE_FIELD(store, retired);
+
+    return projectile_store_reserve(store, capacity);
+}
+
+void projectile_store_free(projectile_store *store) {
+    VALIDATE_PTR(store);
+
+    RELEASE_FIELD(store, ids);
+    RELEASE_FIELD(store, pos_x);
+    RELEASE_FIELD(store, pos_y);
+    RELEASE_FIELD(store, prev_x);
+    RELEASE_FIELD(store, prev_y);
+    RELEASE_FIELD(store, vel_x);
+    RELEASE_FIELD(store, vel_y);
+    RELEASE_FIELD(store, damage);
+    RELEASE_FIELD(store, owner_id);
+    RELEASE_FIELD(store, target_id);
+    RELEASE_FIELD(store, current_frame);
+    RELEASE_FIELD(store, frame_timer);
+    RELEASE_FIELD(store, row);
+    RELEASE_FIELD(store, is_active);
+    RELEASE_FIELD(store, free_slots);
+    RELEASE_FIELD(store, retired);
+
+    *store = (projectile_store){0};
+}
+
+result_code projectile_store_push(projectile_store *store, const game_object *obj) {
+    VALIDATE_PTR_RET(store, result_error_null_ptr);
+    VALIDATE_PTR_RET(obj, result_error_null_ptr);
+
+    size_t i;
+    if (store->free_count > 0) {
+        i = store->free_slots[--store->free_count];
+    }
+    else {
+        if (store->count == store->max_capacity) {
+            return result_error_out_of_memory;
+        }
+        if (store->count == store->capacity) {
+            const result_code res = projectile_store_reserve(store, next_capacity(store->capacity, store->max_capacity));
+            if (res != result_ok) {
+                return res;
+            }
+        }
+        i = store->count++;
+    }
+
+    const projectile_data *data = &obj->data.projectile;
+
+    store->ids[i] = obj->id;
+    store->pos_x[i] = obj->position.x;
+    store->pos_y[i] = obj->position.y;
+    store->prev_x[i] = obj->position.x;
+    store->prev_y[i] = obj->position.y;
+    store->vel_x[i] = data->velocity.x;
+    store->vel_y[i] = data->velocity.y;
+    store->damage[i] = data->damage;
+    store->owner_id[i] = data->owner_id;
+    store->target_id[i] = data->target_id;
+    store->current_frame[i] = data->current_frame;
+    store->frame_timer[i] = data->frame_timer;
+    store->row[i] = data->row;
+    store->is_active[i] = obj->is_active;
+
+    return result_ok;
+}
+
+game_object projectile_store_get(const projectile_store *store, const size_t index) {
+    return (game_object) {
+        .id = store->ids[index],
+        .type = projectile,
+        .position = {store->pos_x[index], store->pos_y[index]},
+        .is_active = store->is_active[index],
+        .data.projectile = {
+            .velocity = {store->vel_x[index], store->vel_y[index]},
+            .damage = store->damage[index],
+            .owner_id = store->owner_id[index],
+            .target_id = store->target_id[index],
+            .current_frame = store->current_frame[index],
+            .frame_timer = store->frame_timer[index],
+            .row = store->row[index]
+        }
+    };
+}
+
+static void projectile_store_move(projectile_store *store, const size_t dst, const size_t src) {
+    store->stats.bytes_moved += projectile_row_size(store);
+    store->ids[dst] = store->ids[src];
+    store->pos_x[dst] = store->pos_x[src];
+    store->pos_y[dst] = store->pos_y[src];
+    store->prev_x[dst] = store->prev_x[src];
+    store->prev_y[dst] = store->prev_y[src];
+    store->vel_x[dst] = store->vel_x[src];
+    store->vel_y[dst] = store->vel_y[src];
+    store->damage[dst] = store->damage[src];
+    store->owner_id[dst] = store->owner_id[src];
+    store->target_id[dst] = store->target_id[src];
+    store->current_frame[dst] = store->current_frame[src];
+    store->frame_timer[dst] = store->frame_timer[src];
+    store->row[dst] = store->row[src];
+    store->is_active[dst] = store->is_active[src];
+}
+
+size_t projectile_store_next_slot(const projectile_store *store) {
+    return store->free_count > 0 ? store->free_slots[store->free_count - 1] : store->count;
+}
+
+void projectile_store_release(projectile_store *store, const size_t index, handle_table *handles) {
+    VALIDATE_PTR(store);
+
+    if (store->ids[index] == INVALID_HANDLE) {
+        return;
+    }
+
+    handle_table_release(handles, store->ids[index]);
+    store->ids[index] = INVALID_HANDLE;
+    store->is_active[index] = false;
+    store->free_slots[store->free_count++] = (uint32_t)index;
+}
+
+// Marks a row that left play on its own; the caller releases retired rows
+// at the end of the tick without scanning the store for them
+void projectile_store_retire(projectile_store *store, const size_t index) {
+    VALIDATE_PTR(store);
+
+    if (!store->is_active[index]) {
+        return;
+    }
+    store->is_active[index] = false;
+    store->retired[store->retired_count++] = (uint32_t)index;
+}
+
+void projectile_store_compact(projectile_store *store, handle_table *handles) {
+    VALIDATE_PTR(store);
+
+    size_t write_index = 0;
+    for (size_t read_index = 0; read_index < store->count; read_index++) {
+        if (!store->is_active[read_index]) {
+            if (store->ids[read_index] != INVALID_HANDLE) {
+                handle_table_release(handles, store->ids[read_index]);
+            }
+            continue;
+        }
+        if (write_index != read_index) {
+            projectile_store_move(store, write_index, read_index);
+            handle_table_relocate(handles, store->ids[write_index], write_index);
+        }
+        write_index++;
+    }
+    store->count = write_index;
+    store->free_count = 0;
+    store->retired_count = 0;
+    store->stats.compactions++;
+
+    if (should_shrink(store->count, store->capacity) &&
+        projectile_store_reserve(store, store->capacity / 2) != result_ok) {
+        fprintf(stderr, "WARNING: Failed to compact projectile store\n");
+    }
+}
+
+void projectile_store_maintain(projectile_store *store, handle_table *handles) {
+    VALIDATE_PTR(store);
+
+    // A store of nothing but released rows has nothing to move
+    if (store->free_count > 0 && store->free_count == store->count) {
+        store->count = 0;
+        store->free_count = 0;
+        if (should_shrink(0, store->capacity) &&
+            projectile_store_reserve(store, store->capacity / 2) != result_ok) {
+            fprintf(stderr, "WARNING: Failed to shrink projectile store\n");
+        }
+        return;
+    }
+
+    if (is_fragmented(store->free_count, store->count)) {
+        projectile_store_compact(store, handles);
+    }
+}
+
+void projectile_store_save_positions(projectile_store *store) {
+    VALIDATE_PTR(store);
+
+    if (store->count == 0) return;
+    memcpy(store->prev_x, store->pos_x, sizeof(*store->pos_x) * store->count);
+    memcpy(store->prev_y, store->pos_y, sizeof(*store->pos_y) * store->count);
+}
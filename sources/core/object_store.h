@@ -0,0 +1,202 @@
+#ifndef PROJEKT_OBJECT_STORE_H
+#define PROJEKT_OBJECT_STORE_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "game_object.h"
+#include "handle_table.h"
+
+// Dead rows stay in place as tombstones and their slots are reused through a
+// free list. A store is compacted once at least half of its rows are
+// tombstones, and shrinks only when less than an eighth of it is in use.
+#define STORE_FRAGMENTATION_DIVISOR 2
+#define STORE_MIN_COMPACT_ROWS 16
+#define STORE_SHRINK_DIVISOR 8
+
+// resizes counts changes to how much of a store's reservation is in use;
+// columns are reserved once, so none of them allocate or move memory
+typedef struct {
+    size_t resizes;
+    size_t bytes_moved;
+    size_t compactions;
+} pool_stats;
+
+typedef struct {
+    int *ids;
+    float *pos_x;
+    float *pos_y;
+    float *prev_x;
+    float *prev_y;
+    float *health;
+    float *max_health;
+    float *speed;
+    float *distance;
+    int *waypoint_index;
+    int *path_id;
+    int *gold_reward;
+    enemy_type *type;
+    enemy_animation_state *anim_state;
+    int *current_frame;
+    float *frame_timer;
+    uint64_t *spawn_tick;
+    uint64_t *hit_tick;
+    bool *is_active;
+
+    uint32_t *free_slots;
+    size_t free_count;
+
+    // Rows deactivated this tick that still hold their handle
+    uint32_t *retired;
+    size_t retired_count;
+
+    size_t count;
+    size_t capacity;
+    size_t max_capacity;
+    pool_stats stats;
+} enemy_store;
+
+typedef struct {
+    int *ids;
+    float *pos_x;
+    float *pos_y;
+    float *damage;
+    float *range;
+    float *fire_cooldown;
+    int *target_id;
+    int *width;
+    int *height;
+    int *upgrade_cost;
+    tower_level *level;
+    tower_fire_mode *fire_mode;
+    tower_target_policy *target_policy;
+    bool *is_active;
+
+    uint32_t *free_slots;
+    size_t free_count;
+
+    size_t count;
+    size_t capacity;
+    size_t max_capacity;
+    pool_stats stats;
+} tower_store;
+
+typedef struct {
+    int *ids;
+    float *pos_x;
+    float *pos_y;
+    float *prev_x;
+    float *prev_y;
+    float *vel_x;
+    float *vel_y;
+    float *damage;
+    int *owner_id;
+    int *target_id;
+    int *current_frame;
+    float *frame_timer;
+    int *row;
+    bool *is_active;
+
+    uint32_t *free_slots;
+    size_t free_count;
+
+    // Rows deactivated this tick that still hold their handle
+    uint32_t *retired;
+    size_t retired_count;
+
+    size_t count;
+    size_t capacity;
+    size_t max_capacity;
+    pool_stats stats;
+} projectile_store;
+
+// Cursors walk the active rows of a store in place, without copying them out.
+// cursor.index is the row being visited; it stays valid until the store is
+// next compacted, so do not add or remove objects while iterating.
+#define STORE_CURSOR_START SIZE_MAX
+
+typedef struct {
+    const enemy_store *store;
+    size_t index;
+} enemy_cursor;
+
+typedef struct {
+    const tower_store *store;
+    size_t index;
+} tower_cursor;
+
+typedef struct {
+    const projectile_store *store;
+    size_t index;
+} projectile_cursor;
+
+// Unsigned wrap takes STORE_CURSOR_START to row 0 on the first call
+#define STORE_CURSOR_NEXT(cursor)                                                       \
+    do {                                                                                \
+        (cursor)->index++;                                                              \
+        while ((cursor)->index < (cursor)->store->count &&                              \
+               !(cursor)->store->is_active[(cursor)->index]) {                          \
+            (cursor)->index++;                                                          \
+        }                                                                               \
+    } while (0)
+
+static inline bool enemy_cursor_next(enemy_cursor *cursor) {
+    STORE_CURSOR_NEXT(cursor);
+    return cursor->index < cursor->store->count;
+}
+
+static inline bool tower_cursor_next(tower_cursor *cursor) {
+    STORE_CURSOR_NEXT(cursor);
+    return cursor->index < cursor->store->count;
+}
+
+static inline bool projectile_cursor_next(projectile_cursor *cursor) {
+    STORE_CURSOR_NEXT(cursor);
+    return cursor->index < cursor->store->count;
+}
+
+#define for_each_enemy(cursor, enemies) \
+    for (enemy_cursor cursor = {.store = (enemies), .index = STORE_CURSOR_START}; enemy_cursor_next(&(cursor));)
+
+#define for_each_tower(cursor, towers) \
+    for (tower_cursor cursor = {.store = (towers), .index = STORE_CURSOR_START}; tower_cursor_next(&(cursor));)
+
+#define for_each_projectile(cursor, projectiles) \
+    for (projectile_cursor cursor = {.store = (projectiles), .index = STORE_CURSOR_START}; \
+         projectile_cursor_next(&(cursor));)
+
+result_code enemy_store_init(enemy_store *store, size_t capacity, size_t max_capacity);
+void enemy_store_free(enemy_store *store);
+result_code enemy_store_reserve(enemy_store *store, size_t capacity);
+result_code enemy_store_push(enemy_store *store, const game_object *obj);
+game_object enemy_store_get(const enemy_store *store, size_t index);
+size_t enemy_store_next_slot(const enemy_store *store);
+void enemy_store_release(enemy_store *store, size_t index, handle_table *handles);
+void enemy_store_retire(enemy_store *store, size_t index);
+void enemy_store_compact(enemy_store *store, handle_table *handles);
+void enemy_store_maintain(enemy_store *store, handle_table *handles);
+void enemy_store_save_positions(enemy_store *store);
+
+result_code tower_store_init(tower_store *store, size_t capacity, size_t max_capacity);
+void tower_store_free(tower_store *store);
+result_code tower_store_reserve(tower_store *store, size_t capacity);
+result_code tower_store_push(tower_store *store, const game_object *obj);
+game_object tower_store_get(const tower_store *store, size_t index);
+size_t tower_store_next_slot(const tower_store *store);
+void tower_store_release(tower_store *store, size_t index, handle_table *handles);
+void tower_store_compact(tower_store *store, handle_table *handles);
+void tower_store_maintain(tower_store *store, handle_table *handles);
+
+result_code projectile_store_init(projectile_store *store, size_t capacity, size_t max_capacity);
+void projectile_store_free(projectile_store *store);
+result_code projectile_store_reserve(projectile_store *store, size_t capacity);
+result_code projectile_store_push(projectile_store *store, const game_object *obj);
+game_object projectile_store_get(const projectile_store *store, size_t index);
+size_t projectile_store_next_slot(const projectile_store *store);
+void projectile_store_release(projectile_store *store, size_t index, handle_table *handles);
+void projectile_store_retire(projectile_store *store, size_t index);
+void projectile_store_compact(projectile_store *store, handle_table *handles);
+void projectile_store_maintain(projectile_store *store, handle_table *handles);
+void projectile_store_save_positions(projectile_store *store);
+
+#endif //PROJEKT_OBJECT_STORE_H
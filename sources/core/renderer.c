@@ -73,100 +73,175 @@ texture_2d get_enemy_texture(const game* g, const enemy_type type, const enemy_a
     }
 }
 
-void draw_game_objects(const game* g) {
-    const int tile_size = get_tile_scale(&g->tilemap);
-
-    for (size_t i = 0; i < g->object_count; i++) {
-        const game_object* obj = &g->game_objects[i];
-
-        if (!obj->is_active) continue;
+static void draw_towers(const game* g) {
+    const tower_store* towers = &g->towers;
 
-        if (obj->type == tower) {
-            const sprite_info info = get_tower_sprites(obj->data.tower.level);
+    for_each_tower(it, towers) {
+        const size_t i = it.index;
+        const sprite_info info = get_tower_sprites(towers->level[i]);
 
-            if (info.sprites == nullptr) {
-                continue;
-            }
+        if (info.sprites == nullptr) {
+            continue;
+        }
 
-            for (int y = 0; y < info.height; y++) {
-                for (int x = 0; x < info.width; x++) {
-                    const int sprite = info.sprites[info.width * y + x];
-                    draw_texture(&g->tilemap, g->assets.towers, sprite, (int)obj->position.x + x, (int)obj->position.y + y);
-                }
+        for (int y = 0; y < info.height; y++) {
+            for (int x = 0; x < info.width; x++) {
+                const int sprite = info.sprites[info.width * y + x];
+                draw_texture(&g->tilemap, g->assets.towers, sprite, (int)towers->pos_x[i] + x, (int)towers->pos_y[i] + y);
             }
         }
-        else if (obj->type == enemy) {
-            const texture_2d texture = get_enemy_texture(g, obj->data.enemy.type, obj->data.enemy.anim_state);
-            const int frame_count = get_enemy_frame_count(obj->data.enemy.type, obj->data.enemy.anim_state);
+    }
+}
 
-            if (texture.id == 0 || frame_count == 0) {
-                continue;
-            }
+static float interpolate(const float previous, const float current, const float alpha) {
+    return previous + (current - previous) * alpha;
+}
+
+// x and y are in tiles
+static void draw_enemy_frame(const game* g, const enemy_type type, const enemy_animation_state state,
+                             const int frame, const float x, const float y, const int tile_size) {
+    const texture_2d texture = get_enemy_texture(g, type, state);
+    const int frame_count = get_enemy_frame_count(type, state);
+
+    if (texture.id == 0 || frame_count == 0) {
+        return;
+    }
 
-            const int frame_width = texture.width / frame_count;
-            const int frame_height = texture.height;
+    const int frame_width = texture.width / frame_count;
+    const int frame_height = texture.height;
 
-            const rectangle source = {
-                (float)(obj->data.enemy.current_frame * frame_width),
-                0,
-                (float)frame_width,
-                (float)frame_height
-            };
+    const rectangle source = {
+        (float)(frame * frame_width),
+        0,
+        (float)frame_width,
+        (float)frame_height
+    };
 
-            const float aspect_ratio = (float)frame_width / (float)frame_height;
-            const float draw_width = (float)tile_size;
-            const float draw_height = draw_width / aspect_ratio;
+    const float aspect_ratio = (float)frame_width / (float)frame_height;
+    const float draw_width = (float)tile_size;
+    const float draw_height = draw_width / aspect_ratio;
 
-            float offset_y = 0;
-            if (draw_height < (float)tile_size) {
-                offset_y = ((float)tile_size - draw_height) / 2.0f;
-            }
+    float offset_y = 0;
+    if (draw_height < (float)tile_size) {
+        offset_y = ((float)tile_size - draw_height) / 2.0f;
+    }
 
-            const rectangle dest = {
-                obj->position.x * (float)tile_size,
-                obj->position.y * (float)tile_size + offset_y,
-                draw_width,
-                draw_height
-            };
+    const rectangle dest = {
+        x * (float)tile_size,
+        y * (float)tile_size + offset_y,
+        draw_width,
+        draw_height
+    };
 
-            draw_texture_pro(texture, source, dest, (vector2){0, 0}, 0.0f, white);
+    draw_texture_pro(texture, source, dest, (vector2){0, 0}, 0.0f, white);
+}
+
+static void draw_enemies(const game* g, const int tile_size) {
+    const enemy_store* enemies = &g->enemies;
+
+    for_each_enemy(it, enemies) {
+        const size_t i = it.index;
+
+        if (g->lazy_enemies) {
+            // Placed straight from the path at the time this frame shows
+            const vector2 position = get_lazy_enemy_position(enemies, i, g->tick, g->render_alpha - 1.0f);
+            enemy_animation_state state;
+            int frame;
+            get_lazy_enemy_animation(enemies, i, g->tick, &state, &frame);
+
+            draw_enemy_frame(g, enemies->type[i], state, frame, position.x, position.y, tile_size);
+            continue;
         }
-        else if (obj->type == projectile) {
-            const texture_2d iceball = g->assets.iceball;
 
-            if (iceball.id == 0) {
-                continue;
-            }
+        draw_enemy_frame(g, enemies->type[i], enemies->anim_state[i], enemies->current_frame[i],
+                         interpolate(enemies->prev_x[i], enemies->pos_x[i], g->render_alpha),
+                         interpolate(enemies->prev_y[i], enemies->pos_y[i], g->render_alpha),
+                         tile_size);
+    }
+
+    const fx_pool* death_effects = &g->death_effects;
 
-            constexpr int frame_width = 84;
-            constexpr int frame_height = 9;
+    for (size_t i = 0; i < death_effects->count; i++) {
+        const death_fx* fx = &death_effects->effects[i];
+        draw_enemy_frame(g, fx->anim, enemy_anim_die, fx->frame, fx->position.x, fx->position.y, tile_size);
+    }
+}
 
-            const int current_frame = obj->data.projectile.current_frame;
+static void draw_projectiles(const game* g, const int tile_size) {
+    const projectile_store* projectiles = &g->projectiles;
+    const impact_schedule* impacts = &g->impacts;
+    const texture_2d iceball = g->assets.iceball;
+
+    if (iceball.id == 0) {
+        return;
+    }
 
-            const rectangle source = {
-                (float)(current_frame * frame_width),
-                0,
-                (float)frame_width,
-                (float)frame_height
-            };
+    constexpr int frame_width = 84;
+    constexpr int frame_height = 9;
 
-            const float projectile_width = (float)tile_size * 2.0f;  // 4x the original 0.5 scale
-            const float projectile_height = projectile_width * ((float)frame_height / (float)frame_width);
+    const float projectile_width = (float)tile_size * 2.0f;  // 4x the original 0.5 scale
+    const float projectile_height = projectile_width * ((float)frame_height / (float)frame_width);
+    const vector2 origin = {projectile_width / 2.0f, projectile_height / 2.0f};
 
-            const float angle = atan2f(obj->data.projectile.velocity.y, obj->data.projectile.velocity.x) * (180.0f / 3.14159f) + 180.0f;
+    for_each_projectile(it, projectiles) {
+        const size_t i = it.index;
+        const rectangle source = {
+            (float)(projectiles->current_frame[i] * frame_width),
+            0,
+            (float)frame_width,
+            (float)frame_height
+        };
 
-            const rectangle dest = {
-                obj->position.x * (float)tile_size,
-                obj->position.y * (float)tile_size,
-                projectile_width,
-                projectile_height
-            };
+        const float angle = atan2f(projectiles->vel_y[i], projectiles->vel_x[i]) * (180.0f / 3.14159f) + 180.0f;
 
-            const vector2 origin = {projectile_width / 2.0f, projectile_height / 2.0f};
+        const rectangle dest = {
+            interpolate(projectiles->prev_x[i], projectiles->pos_x[i], g->render_alpha) * (float)tile_size,
+            interpolate(projectiles->prev_y[i], projectiles->pos_y[i], g->render_alpha) * (float)tile_size,
+            projectile_width,
+            projectile_height
+        };
 
-            draw_texture_pro(iceball, source, dest, origin, angle, white);
-        }
+        draw_texture_pro(iceball, source, dest, origin, angle, white);
     }
+
+    for (size_t i = 0; i < impacts->count; i++) {
+        const impact* shot = &impacts->impacts[i];
+        if (!shot->in_flight) continue;
+
+        // The frame shows the state between the previous tick and this one
+        const float age = (float)(g->tick - shot->fire_tick) - 1.0f + g->render_alpha;
+        const float progress = fminf(fmaxf(age / (float)(shot->impact_tick - shot->fire_tick), 0.0f), 1.0f);
+        const int frame = (int)(fmaxf(age, 0.0f) * SIM_TICK_DURATION / ICEBALL_FRAME_DURATION) % ICEBALL_FRAMES;
+
+        const rectangle source = {
+            (float)(frame * frame_width),
+            0,
+            (float)frame_width,
+            (float)frame_height
+        };
+
+        const float angle = atan2f(shot->to.y - shot->from.y, shot->to.x - shot->from.x) * (180.0f / 3.14159f) + 180.0f;
+
+        const rectangle dest = {
+            interpolate(shot->from.x, shot->to.x, progress) * (float)tile_size,
+            interpolate(shot->from.y, shot->to.y, progress) * (float)tile_size,
+            projectile_width,
+            projectile_height
+        };
+
+        draw_texture_pro(iceball, source, dest, origin, angle, white);
+    }
+}
+
+void draw_game_objects(const game* g) {
+    const int tile_size = get_tile_scale(&g->tilemap);
+
+    // Every object texture is drawn by one batched call, in first-use order
+    begin_sprite_batch();
+    draw_towers(g);
+    draw_enemies(g, tile_size);
+    draw_projectiles(g, tile_size);
+    end_sprite_batch();
 }
 
 void draw_start_screen(const game* g) {
@@ -176,6 +251,7 @@ void draw_start_screen(const game* g) {
     const int y_position = screen_height * 4 / 5;
 
     draw_centered_text_with_shadow("PRESS SPACE TO START", y_position, 35, white);
+    draw_centered_text_with_shadow("PRESS E FOR ENDLESS HORDE", y_position + 45, 20, lightgray);
 }
 
 void draw_game_over_screen(const game* g) {
@@ -198,53 +274,74 @@ void draw_game_over_screen(const game* g) {
     draw_centered_text_with_shadow("PRESS SPACE TO RESTART", screen_height - 80, 30, lightgray);
 }
 
-void draw_hud(const game* g) {
+void draw_hud(const game* g, hud_labels* hud) {
     const int screen_width = get_screen_width();
 
     draw_rectangle(0, 0, screen_width, 50, (color){0, 0, 0, 180});
 
-    char lives_text[64];
-    snprintf(lives_text, sizeof(lives_text), "Lives: %d", g->player_lives);
-    draw_text(lives_text, 20, 15, 25, red);
+    char text[64];
+    if (label_value_changed(&hud->lives, g->player_lives)) {
+        snprintf(text, sizeof(text), "Lives: %d", g->player_lives);
+        set_label_text(&hud->lives, text, 25);
+    }
+    draw_label(&hud->lives, 20, 15, red);
 
-    char money_text[64];
-    snprintf(money_text, sizeof(money_text), "$%d", g->player_money);
-    const int money_x = screen_width / 3;
-    draw_text(money_text, money_x, 15, 25, gold);
+    if (label_value_changed(&hud->money, g->player_money)) {
+        snprintf(text, sizeof(text), "$%d", g->player_money);
+        set_label_text(&hud->money, text, 25);
+    }
+    draw_label(&hud->money, screen_width / 3, 15, gold);
 
-    char score_text[64];
-    snprintf(score_text, sizeof(score_text), "Score: %d", g->enemies_defeated);
-    const int score_x = screen_width * 2 / 3;
-    draw_text(score_text, score_x, 15, 25, skyblue);
+    if (label_value_changed(&hud->score, g->enemies_defeated)) {
+        snprintf(text, sizeof(text), "Score: %d", g->enemies_defeated);
+        set_label_text(&hud->score, text, 25);
+    }
+    draw_label(&hud->score, screen_width * 2 / 3, 15, skyblue);
+
+    if (g->sim_speed > 1 || g->dropped_steps_timer > 0.0f) {
+        const bool dropping = g->dropped_steps_timer > 0.0f;
+        const int64_t shown = dropping ? ((int64_t)g->dropped_steps + 1) << 32 | g->sim_speed : g->sim_speed;
+        if (label_value_changed(&hud->speed, shown)) {
+            if (dropping) {
+                snprintf(text, sizeof(text), "%dx -%d", g->sim_speed, g->dropped_steps);
+            } else {
+                snprintf(text, sizeof(text), "%dx", g->sim_speed);
+            }
+            set_label_text(&hud->speed, text, 20);
+        }
+        draw_label(&hud->speed, screen_width - hud->speed.width - 20, 17, dropping ? red : lightgray);
+    }
 }
 
-void draw_wave_info(const game* g) {
+void draw_wave_info(const game* g, hud_labels* hud) {
     const int tile_size = get_tile_scale(&g->tilemap);
     const int map_width_pixels = g->tilemap.map_width * tile_size;
 
-    char wave_text[64];
-    snprintf(wave_text, sizeof(wave_text), "Wave %d", g->current_wave + 1);
+    char text[64];
+    if (label_value_changed(&hud->wave, g->current_wave)) {
+        snprintf(text, sizeof(text), "Wave %d", g->current_wave + 1);
+        set_label_text(&hud->wave, text, 30);
+    }
 
     constexpr int font_size = 30;
-    const int text_width = measure_text(wave_text, font_size);
+    const int text_width = hud->wave.width;
     const int x = map_width_pixels - text_width - 20;
     constexpr int y = 60;
 
     draw_rectangle(x - 10, y - 5, text_width + 20, font_size + 10, (color){0, 0, 0, 180});
 
-    draw_text(wave_text, x, y, font_size, (color){255, 200, 0, 255});
+    draw_label(&hud->wave, x, y, (color){255, 200, 0, 255});
 
-    const wave_config wave = get_wave_config(g->current_wave);
-    char progress_text[64];
-    snprintf(progress_text, sizeof(progress_text), "%d/%d enemies",
-             g->enemies_spawned_in_wave, wave.enemy_count);
+    const wave_config wave = get_game_wave_config(g, g->current_wave);
+    if (label_value_changed(&hud->progress, (int64_t)g->enemies_spawned_in_wave << 32 | (uint32_t)wave.enemy_count)) {
+        snprintf(text, sizeof(text), "%d/%d enemies", g->enemies_spawned_in_wave, wave.enemy_count);
+        set_label_text(&hud->progress, text, 18);
+    }
 
-    constexpr int progress_font_size = 18;
-    const int progress_width = measure_text(progress_text, progress_font_size);
-    const int progress_x = map_width_pixels - progress_width - 20;
+    const int progress_x = map_width_pixels - hud->progress.width - 20;
     constexpr int progress_y = y + font_size + 10;
 
-    draw_text(progress_text, progress_x, progress_y, progress_font_size, (color){200, 200, 200, 255});
+    draw_label(&hud->progress, progress_x, progress_y, (color){200, 200, 200, 255});
 }
 
 void draw_wave_break_screen(const game* g) {
@@ -257,7 +354,7 @@ void draw_wave_break_screen(const game* g) {
     snprintf(complete_text, sizeof(complete_text), "WAVE %d COMPLETE!", g->current_wave + 1);
     draw_centered_text_with_shadow(complete_text, screen_height / 2 - 80, 50, green);
 
-    const wave_config next_wave = get_wave_config(g->current_wave + 1);
+    const wave_config next_wave = get_game_wave_config(g, g->current_wave + 1);
     char next_wave_text[128];
     snprintf(next_wave_text, sizeof(next_wave_text), "Next: Wave %d (%d enemies)",
              g->current_wave + 2, next_wave.enemy_count);
@@ -270,40 +367,66 @@ void draw_wave_break_screen(const game* g) {
     draw_centered_text_with_shadow("PRESS SPACE TO START NOW", screen_height / 2 + 60, 20, lightgray);
 }
 
-void draw_tower_info(const game_object* tower_object, const int x, const int y) {
-    if (tower_object == nullptr || tower_object->type != tower) {
+void draw_tower_info(const game* g, hud_labels* hud, const int tower_index, const int x, const int y) {
+    if (g == nullptr || hud == nullptr || tower_index < 0 || (size_t)tower_index >= g->towers.count) {
         return;
     }
 
-    if (tower_object->data.tower.level <= level_0) {
+    const tower_level level = g->towers.level[tower_index];
+
+    if (level <= level_0) {
         return;
     }
 
-    const char* tower_name = "Ice Tower";
-    char level_text[32];
-    snprintf(level_text, sizeof(level_text), "Level %u", tower_object->data.tower.level);
-
     constexpr int padding = 10;
     constexpr int font_size = 20;
-    const int name_width = measure_text(tower_name, font_size);
-    const int level_width = measure_text(level_text, font_size);
-    const int max_width = name_width > level_width ? name_width : level_width;
+
+    set_label_text(&hud->tower_name, "Ice Tower", font_size);
+
+    char text[32];
+    if (label_value_changed(&hud->tower_level, level)) {
+        snprintf(text, sizeof(text), "Level %u", level);
+        set_label_text(&hud->tower_level, text, font_size);
+    }
+
+    const tower_target_policy policy = g->towers.target_policy[tower_index];
+    if (label_value_changed(&hud->tower_policy, policy)) {
+        snprintf(text, sizeof(text), "Target: %s", get_target_policy_name(policy));
+        set_label_text(&hud->tower_policy, text, font_size);
+    }
+
+    int max_width = hud->tower_name.width > hud->tower_level.width ? hud->tower_name.width : hud->tower_level.width;
+    max_width = hud->tower_policy.width > max_width ? hud->tower_policy.width : max_width;
 
     const int box_width = max_width + padding * 2;
-    constexpr int box_height = font_size * 2 + padding * 3;
+    constexpr int box_height = font_size * 3 + padding * 4;
 
     draw_rectangle(x, y, box_width, box_height, (color){0, 0, 0, 200});
     draw_rectangle_lines(x, y, box_width, box_height, (color){100, 200, 255, 255});
 
-    draw_text(tower_name, x + padding, y + padding, font_size, skyblue);
+    draw_label(&hud->tower_name, x + padding, y + padding, skyblue);
 
-    draw_text(level_text, x + padding, y + padding * 2 + font_size, font_size, gold);
+    draw_label(&hud->tower_level, x + padding, y + padding * 2 + font_size, gold);
+
+    draw_label(&hud->tower_policy, x + padding, y + padding * 3 + font_size * 2, lightgray);
+}
+
+void unload_hud(hud_labels* hud) {
+    if (hud == nullptr) return;
+
+    text_label* const labels[] = {
+        &hud->lives, &hud->money, &hud->score, &hud->speed, &hud->wave,
+        &hud->progress, &hud->tower_name, &hud->tower_level, &hud->tower_policy,
+    };
+    for (size_t i = 0; i < sizeof(labels) / sizeof(labels[0]); i++) {
+        unload_label(labels[i]);
+    }
 }
 
 void draw_tower_spots(const game* g) {
     const int tile_size = get_tile_scale(&g->tilemap);
 
-    for (int i = 0; i < 4; i++) {
+    for (int i = 0; i < TOWER_SPOT_COUNT; i++) {
         const tower_spot* spot = &g->tower_spots[i];
 
         if (!spot->occupied) {
@@ -10,9 +10,25 @@
 
 typedef struct game game;
 
+// HUD text kept between frames by whoever draws a board; each label is
+// re-formatted only when the values it shows change
+typedef struct {
+    text_label lives;
+    text_label money;
+    text_label score;
+    text_label speed;
+    text_label wave;
+    text_label progress;
+    text_label tower_name;
+    text_label tower_level;
+    text_label tower_policy;
+} hud_labels;
+
 void draw_game_objects(const game* g);
 
-void draw_hud(const game* g);
+void draw_hud(const game* g, hud_labels* hud);
+
+void unload_hud(hud_labels* hud);
 
 void draw_start_screen(const game* g);
 
@@ -24,11 +40,11 @@ void draw_text_with_shadow(const char* text, int x, int y, int size, color c);
 
 void draw_centered_text_with_shadow(const char* text, int y, int size, color c);
 
-void draw_tower_info(const game_object* tower_object, int x, int y);
+void draw_tower_info(const game* g, hud_labels* hud, int tower_index, int x, int y);
 
 void draw_tower_spots(const game* g);
 
-void draw_wave_info(const game* g);
+void draw_wave_info(const game* g, hud_labels* hud);
 void draw_wave_break_screen(const game* g);
 
 texture_2d get_enemy_texture(const game* g, enemy_type type, enemy_animation_state state);
@@ -0,0 +1,134 @@
+#include "simd_kernels.h"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define SIMD_LANES 8
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#define SIMD_LANES 4
+#else
+#define SIMD_LANES 1
+#endif
+
+const char *simd_kernel_name(void) {
+#if defined(__AVX2__)
+    return "avx2";
+#elif defined(__SSE2__)
+    return "sse2";
+#else
+    return "scalar";
+#endif
+}
+
+void simd_advance_distances(float *distance, const float *speed, const size_t count, const float delta_time) {
+    size_t i = 0;
+
+#if defined(__AVX2__)
+    const __m256 dt = _mm256_set1_ps(delta_time);
+    for (; i + 8 <= count; i += 8) {
+        const __m256 step = _mm256_mul_ps(_mm256_loadu_ps(speed + i), dt);
+        _mm256_storeu_ps(distance + i, _mm256_add_ps(_mm256_loadu_ps(distance + i), step));
+    }
+#elif defined(__SSE2__)
+    const __m128 dt = _mm_set1_ps(delta_time);
+    for (; i + 4 <= count; i += 4) {
+        const __m128 step = _mm_mul_ps(_mm_loadu_ps(speed + i), dt);
+        _mm_storeu_ps(distance + i, _mm_add_ps(_mm_loadu_ps(distance + i), step));
+    }
+#endif
+
+    for (; i < count; i++) {
+        distance[i] += speed[i] * delta_time;
+    }
+}
+
+// Picks the lane with the smallest distance, preferring the lowest index on
+// a tie so the result matches a front-to-back scalar scan.
+[[maybe_unused]]
+static int reduce_lanes(const float *lane_dist, const int *lane_index, float *best_dist_sq) {
+    int best = -1;
+    for (int lane = 0; lane < SIMD_LANES; lane++) {
+        if (lane_index[lane] < 0) continue;
+        if (lane_dist[lane] < *best_dist_sq ||
+            (best >= 0 && !(lane_dist[lane] > *best_dist_sq) && lane_index[lane] < best)) {
+            *best_dist_sq = lane_dist[lane];
+            best = lane_index[lane];
+        }
+    }
+    return best;
+}
+
+int simd_nearest_point(const float *xs, const float *ys, const size_t count,
+                       const float cx, const float cy, float *best_dist_sq) {
+    int best = -1;
+    size_t i = 0;
+
+#if defined(__AVX2__)
+    if (count >= 8) {
+        const __m256 center_x = _mm256_set1_ps(cx);
+        const __m256 center_y = _mm256_set1_ps(cy);
+        __m256 lane_best = _mm256_set1_ps(*best_dist_sq);
+        __m256i lane_index = _mm256_set1_epi32(-1);
+        __m256i index = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+        const __m256i stride = _mm256_set1_epi32(8);
+
+        for (; i + 8 <= count; i += 8) {
+            const __m256 dx = _mm256_sub_ps(_mm256_loadu_ps(xs + i), center_x);
+            const __m256 dy = _mm256_sub_ps(_mm256_loadu_ps(ys + i), center_y);
+            const __m256 dist = _mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_mul_ps(dy, dy));
+            const __m256 closer = _mm256_cmp_ps(dist, lane_best, _CMP_LT_OQ);
+
+            lane_best = _mm256_blendv_ps(lane_best, dist, closer);
+            lane_index = _mm256_castps_si256(_mm256_blendv_ps(
+                _mm256_castsi256_ps(lane_index), _mm256_castsi256_ps(index), closer));
+            index = _mm256_add_epi32(index, stride);
+        }
+
+        float lane_dist[8];
+        int lane_best_index[8];
+        _mm256_storeu_ps(lane_dist, lane_best);
+        _mm256_storeu_si256((__m256i *)(void *)lane_best_index, lane_index);
+        best = reduce_lanes(lane_dist, lane_best_index, best_dist_sq);
+    }
+#elif defined(__SSE2__)
+    if (count >= 4) {
+        const __m128 center_x = _mm_set1_ps(cx);
+        const __m128 center_y = _mm_set1_ps(cy);
+        __m128 lane_best = _mm_set1_ps(*best_dist_sq);
+        __m128i lane_index = _mm_set1_epi32(-1);
+        __m128i index = _mm_setr_epi32(0, 1, 2, 3);
+        const __m128i stride = _mm_set1_epi32(4);
+
+        for (; i + 4 <= count; i += 4) {
+            const __m128 dx = _mm_sub_ps(_mm_loadu_ps(xs + i), center_x);
+            const __m128 dy = _mm_sub_ps(_mm_loadu_ps(ys + i), center_y);
+            const __m128 dist = _mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy));
+            const __m128 closer = _mm_cmplt_ps(dist, lane_best);
+            const __m128i closer_bits = _mm_castps_si128(closer);
+
+            lane_best = _mm_or_ps(_mm_and_ps(closer, dist), _mm_andnot_ps(closer, lane_best));
+            lane_index = _mm_or_si128(_mm_and_si128(closer_bits, index), _mm_andnot_si128(closer_bits, lane_index));
+            index = _mm_add_epi32(index, stride);
+        }
+
+        float lane_dist[4];
+        int lane_best_index[4];
+        _mm_storeu_ps(lane_dist, lane_best);
+        _mm_storeu_si128((__m128i *)(void *)lane_best_index, lane_index);
+        best = reduce_lanes(lane_dist, lane_best_index, best_dist_sq);
+    }
+#endif
+
+    for (; i < count; i++) {
+        const float dx = xs[i] - cx;
+        const float dy = ys[i] - cy;
+        const float dist = dx * dx + dy * dy;
+
+        if (dist < *best_dist_sq) {
+            *best_dist_sq = dist;
+            best = (int)i;
+        }
+    }
+
+    return best;
+}
@@ -0,0 +1,19 @@
+#ifndef PROJEKT_SIMD_KERNELS_H
+#define PROJEKT_SIMD_KERNELS_H
+
+#include <stddef.h>
+
+// Hot loops over structure-of-arrays data. The instruction set is picked at
+// compile time (AVX2, then SSE2, then plain C) and every variant returns the
+// same result as the scalar loop, including which element wins a tie.
+
+const char *simd_kernel_name(void);
+
+// distance[i] += speed[i] * delta_time for every element
+void simd_advance_distances(float *distance, const float *speed, size_t count, float delta_time);
+
+// Index of the point closest to (cx, cy) whose squared distance is below
+// *best_dist_sq, or -1. On a hit *best_dist_sq is lowered to that distance.
+int simd_nearest_point(const float *xs, const float *ys, size_t count, float cx, float cy, float *best_dist_sq);
+
+#endif //PROJEKT_SIMD_KERNELS_H
@@ -0,0 +1,114 @@
+#include "spatial_grid.h"
+#include "game.h"
+
+#include <stdlib.h>
+
+static int clamp_cell(const float value, const int limit) {
+    if (!(value >= 0.0f)) return 0;
+    if (value >= (float)limit) return limit - 1;
+    return (int)value;
+}
+
+result_code spatial_grid_init(spatial_grid *grid, const int cols, const int rows) {
+    VALIDATE_PTR_RET(grid, result_error_null_ptr);
+
+    *grid = (spatial_grid){0};
+    if (cols <= 0 || rows <= 0) {
+        return result_error_out_of_bounds;
+    }
+
+    grid->cell_start = calloc((size_t)(cols * rows) + 1, sizeof(uint32_t));
+    if (grid->cell_start == nullptr) {
+        return result_error_out_of_memory;
+    }
+
+    grid->cols = cols;
+    grid->rows = rows;
+    return result_ok;
+}
+
+void spatial_grid_free(spatial_grid *grid) {
+    VALIDATE_PTR(grid);
+
+    free(grid->cell_start);
+    free(grid->items);
+    free(grid->item_x);
+    free(grid->item_y);
+    *grid = (spatial_grid){0};
+}
+
+result_code spatial_grid_build(spatial_grid *grid, const enemy_store *enemies) {
+    VALIDATE_PTR_RET(grid, result_error_null_ptr);
+    VALIDATE_PTR_RET(enemies, result_error_null_ptr);
+
+    if (enemies->count > grid->item_capacity) {
+        uint32_t *items = realloc(grid->items, sizeof(uint32_t) * enemies->capacity);
+        if (items == nullptr) {
+            return result_error_out_of_memory;
+        }
+        grid->items = items;
+
+        float *item_x = realloc(grid->item_x, sizeof(float) * enemies->capacity);
+        if (item_x == nullptr) {
+            return result_error_out_of_memory;
+        }
+        grid->item_x = item_x;
+
+        float *item_y = realloc(grid->item_y, sizeof(float) * enemies->capacity);
+        if (item_y == nullptr) {
+            return result_error_out_of_memory;
+        }
+        grid->item_y = item_y;
+        grid->item_capacity = enemies->capacity;
+    }
+
+    const size_t cell_count = (size_t)(grid->cols * grid->rows);
+    uint32_t *cell_start = grid->cell_start;
+
+    for (size_t c = 0; c <= cell_count; c++) {
+        cell_start[c] = 0;
+    }
+
+    for (size_t i = 0; i < enemies->count; i++) {
+        if (!enemies->is_active[i]) {
+            continue;
+        }
+        const int cell = spatial_grid_cell(grid,
+                                           clamp_cell(enemies->pos_x[i], grid->cols),
+                                           clamp_cell(enemies->pos_y[i], grid->rows));
+        cell_start[cell + 1]++;
+    }
+
+    for (size_t c = 0; c < cell_count; c++) {
+        cell_start[c + 1] += cell_start[c];
+    }
+
+    for (size_t i = 0; i < enemies->count; i++) {
+        if (!enemies->is_active[i]) {
+            continue;
+        }
+        const int cell = spatial_grid_cell(grid,
+                                           clamp_cell(enemies->pos_x[i], grid->cols),
+                                           clamp_cell(enemies->pos_y[i], grid->rows));
+        grid->items[cell_start[cell]] = (uint32_t)i;
+        grid->item_x[cell_start[cell]] = enemies->pos_x[i];
+        grid->item_y[cell_start[cell]] = enemies->pos_y[i];
+        cell_start[cell]++;
+    }
+
+    for (size_t c = cell_count; c > 0; c--) {
+        cell_start[c] = cell_start[c - 1];
+    }
+    cell_start[0] = 0;
+
+    return result_ok;
+}
+
+grid_bounds spatial_grid_query_bounds(const spatial_grid *grid, const float x, const float y, const float radius) {
+    return (grid_bounds) {
+        .min_x = clamp_cell(x - radius, grid->cols),
+        .min_y = clamp_cell(y - radius, grid->rows),
+        .max_x = clamp_cell(x + radius, grid->cols),
+        .max_y = clamp_cell(y + radius, grid->rows)
+    };
+}
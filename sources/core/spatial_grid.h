@@ -0,0 +1,37 @@
+#ifndef PROJEKT_SPATIAL_GRID_H
+#define PROJEKT_SPATIAL_GRID_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "object_store.h"
+
+typedef struct {
+    int min_x;
+    int min_y;
+    int max_x;
+    int max_y;
+} grid_bounds;
+
+// items holds enemy indices sorted by cell, row-major, with item_x/item_y
+// the matching positions; a row of cells is one contiguous span.
+typedef struct {
+    int cols;
+    int rows;
+    uint32_t *cell_start;
+    uint32_t *items;
+    float *item_x;
+    float *item_y;
+    size_t item_capacity;
+} spatial_grid;
+
+result_code spatial_grid_init(spatial_grid *grid, int cols, int rows);
+void spatial_grid_free(spatial_grid *grid);
+result_code spatial_grid_build(spatial_grid *grid, const enemy_store *enemies);
+grid_bounds spatial_grid_query_bounds(const spatial_grid *grid, float x, float y, float radius);
+
+static inline int spatial_grid_cell(const spatial_grid *grid, const int x, const int y) {
+    return y * grid->cols + x;
+}
+
+#endif //PROJEKT_SPATIAL_GRID_H
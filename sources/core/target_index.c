@@ -0,0 +1,409 @@
+#include "target_index.h"
+#include "game.h"
+#include "vm_region.h"
+
+#include <float.h>
+
+// Every array is reserved for all handle slots up front; pages are only
+// backed once an enemy with that slot is listed
+result_code target_index_init(target_index *index, const size_t max_slots) {
+    VALIDATE_PTR_RET(index, result_error_null_ptr);
+
+    *index = (target_index){0};
+    index->capacity = max_slots;
+
+    index->ids = vm_region_reserve(sizeof(int) * max_slots);
+    index->prev = vm_region_reserve(sizeof(int32_t) * max_slots);
+    index->next = vm_region_reserve(sizeof(int32_t) * max_slots);
+    index->lane = vm_region_reserve(sizeof(uint8_t) * max_slots);
+    index->weakest.entries = vm_region_reserve(sizeof(target_entry) * max_slots);
+    index->weakest.pos = vm_region_reserve(sizeof(uint32_t) * max_slots);
+    index->strongest.entries = vm_region_reserve(sizeof(target_entry) * max_slots);
+    index->strongest.pos = vm_region_reserve(sizeof(uint32_t) * max_slots);
+
+    if (index->ids == nullptr || index->prev == nullptr || index->next == nullptr || index->lane == nullptr ||
+        index->weakest.entries == nullptr || index->weakest.pos == nullptr ||
+        index->strongest.entries == nullptr || index->strongest.pos == nullptr) {
+        return result_error_out_of_memory;
+    }
+
+    target_index_clear(index);
+    return result_ok;
+}
+
+void target_index_free(target_index *index) {
+    VALIDATE_PTR(index);
+
+    const size_t slots = index->capacity;
+    vm_region_release(index->ids, sizeof(int) * slots);
+    vm_region_release(index->prev, sizeof(int32_t) * slots);
+    vm_region_release(index->next, sizeof(int32_t) * slots);
+    vm_region_release(index->lane, sizeof(uint8_t) * slots);
+    vm_region_release(index->weakest.entries, sizeof(target_entry) * slots);
+    vm_region_release(index->weakest.pos, sizeof(uint32_t) * slots);
+    vm_region_release(index->strongest.entries, sizeof(target_entry) * slots);
+    vm_region_release(index->strongest.pos, sizeof(uint32_t) * slots);
+
+    *index = (target_index){0};
+}
+
+void target_index_clear(target_index *index) {
+    VALIDATE_PTR(index);
+
+    for (size_t l = 0; l < TARGET_LANE_COUNT; l++) {
+        index->lanes[l] = (target_lane){.head = TARGET_NO_SLOT, .tail = TARGET_NO_SLOT};
+    }
+    index->weakest.count = 0;
+    index->strongest.count = 0;
+}
+
+static void heap_place(target_heap *heap, const size_t pos, const target_entry entry) {
+    heap->entries[pos] = entry;
+    heap->pos[entry.slot] = (uint32_t)pos;
+}
+
+static void heap_sift_up(target_heap *heap, size_t child) {
+    const target_entry entry = heap->entries[child];
+
+    while (child > 0) {
+        const size_t parent = (child - 1) / 2;
+        if (heap->entries[parent].key <= entry.key) {
+            break;
+        }
+        heap_place(heap, child, heap->entries[parent]);
+        child = parent;
+    }
+    heap_place(heap, child, entry);
+}
+
+static void heap_sift_down(target_heap *heap, size_t parent) {
+    const target_entry entry = heap->entries[parent];
+
+    for (;;) {
+        const size_t left = parent * 2 + 1;
+        if (left >= heap->count) {
+            break;
+        }
+        const size_t right = left + 1;
+        const size_t smallest = right < heap->count && heap->entries[right].key < heap->entries[left].key
+                                    ? right : left;
+        if (entry.key <= heap->entries[smallest].key) {
+            break;
+        }
+        heap_place(heap, parent, heap->entries[smallest]);
+        parent = smallest;
+    }
+    heap_place(heap, parent, entry);
+}
+
+static void heap_push(target_heap *heap, const uint32_t slot, const float key) {
+    const size_t pos = heap->count++;
+    heap_place(heap, pos, (target_entry){.key = key, .slot = slot});
+    heap_sift_up(heap, pos);
+}
+
+static void heap_remove(target_heap *heap, const uint32_t slot) {
+    const size_t pos = heap->pos[slot];
+    const target_entry last = heap->entries[--heap->count];
+    if (pos == heap->count) {
+        return;
+    }
+
+    heap_place(heap, pos, last);
+    heap_sift_up(heap, pos);
+    heap_sift_down(heap, heap->pos[last.slot]);
+}
+
+static void heap_rekey(target_heap *heap, const uint32_t slot, const float key) {
+    heap->entries[heap->pos[slot]].key = key;
+    heap_sift_up(heap, heap->pos[slot]);
+    heap_sift_down(heap, heap->pos[slot]);
+}
+
+static bool is_listed(const target_index *index, const int id) {
+    if (id < 0 || handle_slot(id) >= index->capacity) {
+        return false;
+    }
+
+    const uint32_t slot = handle_slot(id);
+    const size_t pos = index->weakest.pos[slot];
+    return pos < index->weakest.count && index->weakest.entries[pos].slot == slot && index->ids[slot] == id;
+}
+
+// Enemies are listed as they spawn, so appending keeps each lane in spawn order
+void target_index_insert(target_index *index, const enemy_store *enemies, const size_t row) {
+    VALIDATE_PTR(index);
+    VALIDATE_PTR(enemies);
+
+    const int id = enemies->ids[row];
+    const int path_id = enemies->path_id[row];
+    const enemy_type type = enemies->type[row];
+
+    if (!enemies->is_active[row] || path_id < 0 || path_id >= PATH_COUNT ||
+        type >= enemy_type_count || id < 0 || handle_slot(id) >= index->capacity || is_listed(index, id)) {
+        return;
+    }
+
+    const uint32_t slot = handle_slot(id);
+    const int lane_id = path_id * enemy_type_count + (int)type;
+    target_lane* lane = &index->lanes[lane_id];
+
+    index->ids[slot] = id;
+    index->lane[slot] = (uint8_t)lane_id;
+    index->prev[slot] = lane->tail;
+    index->next[slot] = TARGET_NO_SLOT;
+    if (lane->tail == TARGET_NO_SLOT) {
+        lane->head = (int32_t)slot;
+    } else {
+        index->next[lane->tail] = (int32_t)slot;
+    }
+    lane->tail = (int32_t)slot;
+
+    heap_push(&index->weakest, slot, enemies->health[row]);
+    heap_push(&index->strongest, slot, -enemies->health[row]);
+}
+
+void target_index_remove(target_index *index, const int id) {
+    VALIDATE_PTR(index);
+
+    if (!is_listed(index, id)) {
+        return;
+    }
+
+    const uint32_t slot = handle_slot(id);
+    target_lane* lane = &index->lanes[index->lane[slot]];
+    const int32_t prev = index->prev[slot];
+    const int32_t next = index->next[slot];
+
+    if (prev == TARGET_NO_SLOT) {
+        lane->head = next;
+    } else {
+        index->next[prev] = next;
+    }
+    if (next == TARGET_NO_SLOT) {
+        lane->tail = prev;
+    } else {
+        index->prev[next] = prev;
+    }
+
+    heap_remove(&index->weakest, slot);
+    heap_remove(&index->strongest, slot);
+}
+
+void target_index_update_health(target_index *index, const int id, const float health) {
+    VALIDATE_PTR(index);
+
+    if (!is_listed(index, id)) {
+        return;
+    }
+
+    const uint32_t slot = handle_slot(id);
+    heap_rekey(&index->weakest, slot, health);
+    heap_rekey(&index->strongest, slot, -health);
+}
+
+static bool is_in_range(const enemy_store *enemies, const size_t row, const vector2 center, const float range) {
+    const float dx = enemies->pos_x[row] - center.x;
+    const float dy = enemies->pos_y[row] - center.y;
+    return dx * dx + dy * dy < range * range;
+}
+
+// Row of a listed enemy that can still be shot this tick, else -1
+static int targetable_row(const target_index *index, const enemy_store *enemies, const handle_table *handles,
+                          const uint32_t slot) {
+    const int row = handle_table_resolve(handles, index->ids[slot], enemy);
+    return row >= 0 && enemies->is_active[row] ? row : -1;
+}
+
+static float remaining_distance(const enemy_store *enemies, const size_t row) {
+    return get_path_length(enemies->path_id[row]) - enemies->distance[row];
+}
+
+// Merges the lanes from their front or back. Returns true with the first
+// enemy in range, or with INVALID_HANDLE once every lane is used up; false
+// means limit entries were passed without deciding.
+static bool walk_lanes(const target_index *index, const enemy_store *enemies, const handle_table *handles,
+                       const bool from_back, const vector2 center, const float range, const size_t limit,
+                       int *out_id) {
+    int32_t cursor[TARGET_LANE_COUNT];
+    for (size_t l = 0; l < TARGET_LANE_COUNT; l++) {
+        cursor[l] = from_back ? index->lanes[l].tail : index->lanes[l].head;
+    }
+
+    for (size_t visited = 0; visited < limit; visited++) {
+        size_t best_lane = TARGET_LANE_COUNT;
+        int best_row = -1;
+        float best_key = FLT_MAX;
+
+        for (size_t l = 0; l < TARGET_LANE_COUNT; l++) {
+            if (cursor[l] == TARGET_NO_SLOT) {
+                continue;
+            }
+            const int row = targetable_row(index, enemies, handles, (uint32_t)cursor[l]);
+            const float remaining = row >= 0 ? remaining_distance(enemies, (size_t)row) : 0.0f;
+            const float key = row < 0 ? -FLT_MAX : from_back ? -remaining : remaining;
+            if (best_lane == TARGET_LANE_COUNT || key < best_key) {
+                best_lane = l;
+                best_row = row;
+                best_key = key;
+            }
+        }
+
+        if (best_lane == TARGET_LANE_COUNT) {
+            *out_id = INVALID_HANDLE;
+            return true;
+        }
+
+        const uint32_t slot = (uint32_t)cursor[best_lane];
+        cursor[best_lane] = from_back ? index->prev[slot] : index->next[slot];
+
+        if (best_row >= 0 && is_in_range(enemies, (size_t)best_row, center, range)) {
+            *out_id = index->ids[slot];
+            return true;
+        }
+    }
+
+    return false;
+}
+
+// Visits heap entries in key order by keeping the children of every entry
+// seen so far as a frontier; the frontier never outgrows the walk
+static bool walk_heap(const target_index *index, const target_heap *heap, const enemy_store *enemies,
+                      const handle_table *handles, const vector2 center, const float range, const size_t limit,
+                      int *out_id) {
+    target_entry frontier[TARGET_WALK_LIMIT + 1];
+    size_t frontier_count = 0;
+
+    if (heap->count > 0) {
+        frontier[frontier_count++] = (target_entry){.key = heap->entries[0].key, .slot = 0};
+    }
+
+    for (size_t visited = 0; visited < limit && visited < TARGET_WALK_LIMIT; visited++) {
+        if (frontier_count == 0) {
+            *out_id = INVALID_HANDLE;
+            return true;
+        }
+
+        size_t best = 0;
+        for (size_t f = 1; f < frontier_count; f++) {
+            if (frontier[f].key < frontier[best].key) {
+                best = f;
+            }
+        }
+        const size_t pos = frontier[best].slot;
+        frontier[best] = frontier[--frontier_count];
+
+        const uint32_t slot = heap->entries[pos].slot;
+        const int row = targetable_row(index, enemies, handles, slot);
+        if (row >= 0 && is_in_range(enemies, (size_t)row, center, range)) {
+            *out_id = index->ids[slot];
+            return true;
+        }
+
+        for (size_t child = pos * 2 + 1; child <= pos * 2 + 2 && child < heap->count; child++) {
+            frontier[frontier_count++] = (target_entry){.key = heap->entries[child].key, .slot = (uint32_t)child};
+        }
+    }
+
+    if (frontier_count == 0) {
+        *out_id = INVALID_HANDLE;
+        return true;
+    }
+    return false;
+}
+
+// Lower is better, matching the order each policy walks in
+static float policy_key(const enemy_store *enemies, const size_t row, const tower_target_policy policy) {
+    switch (policy) {
+        case target_policy_first: return remaining_distance(enemies, row);
+        case target_policy_last: return -remaining_distance(enemies, row);
+        case target_policy_strongest: return -enemies->health[row];
+        case target_policy_weakest: return enemies->health[row];
+        case target_policy_nearest:
+        case target_policy_count:
+        default: return 0.0f;
+    }
+}
+
+static int scan_grid(const enemy_store *enemies, const spatial_grid *grid, const grid_bounds bounds,
+                     const tower_target_policy policy, const vector2 center, const float range) {
+    int best_row = -1;
+    float best_key = FLT_MAX;
+
+    for (int cy = bounds.min_y; cy <= bounds.max_y; cy++) {
+        const uint32_t begin = grid->cell_start[spatial_grid_cell(grid, bounds.min_x, cy)];
+        const uint32_t end = grid->cell_start[spatial_grid_cell(grid, bounds.max_x, cy) + 1];
+
+        for (uint32_t i = begin; i < end; i++) {
+            const float dx = grid->item_x[i] - center.x;
+            const float dy = grid->item_y[i] - center.y;
+            const uint32_t row = grid->items[i];
+            if (dx * dx + dy * dy >= range * range || !enemies->is_active[row]) {
+                continue;
+            }
+
+            const float key = policy_key(enemies, row, policy);
+            if (best_row < 0 || key < best_key) {
+                best_row = (int)row;
+                best_key = key;
+            }
+        }
+    }
+
+    return best_row < 0 ? INVALID_HANDLE : enemies->ids[best_row];
+}
+
+// Follows the policy's ordering while the best-ranked enemies tend to be in
+// range and otherwise scans the grid cells the range covers, so a select
+// never costs more than the enemies near the tower plus a short walk
+int target_index_select(const target_index *index, const enemy_store *enemies, const handle_table *handles,
+                        const spatial_grid *grid, const tower_target_policy policy,
+                        const vector2 center, const float range) {
+    VALIDATE_PTR_RET(index, INVALID_HANDLE);
+    VALIDATE_PTR_RET(enemies, INVALID_HANDLE);
+    VALIDATE_PTR_RET(handles, INVALID_HANDLE);
+    VALIDATE_PTR_RET(grid, INVALID_HANDLE);
+
+    if (policy == target_policy_nearest || policy >= target_policy_count) {
+        return INVALID_HANDLE;
+    }
+
+    const grid_bounds bounds = spatial_grid_query_bounds(grid, center.x, center.y, range);
+    size_t candidates = 0;
+    for (int cy = bounds.min_y; cy <= bounds.max_y; cy++) {
+        candidates += grid->cell_start[spatial_grid_cell(grid, bounds.max_x, cy) + 1] -
+                      grid->cell_start[spatial_grid_cell(grid, bounds.min_x, cy)];
+    }
+    if (candidates == 0) {
+        return INVALID_HANDLE;
+    }
+
+    if (candidates > TARGET_WALK_LIMIT) {
+        int id = INVALID_HANDLE;
+        bool decided;
+        switch (policy) {
+            case target_policy_first:
+                decided = walk_lanes(index, enemies, handles, false, center, range, TARGET_WALK_LIMIT, &id);
+                break;
+            case target_policy_last:
+                decided = walk_lanes(index, enemies, handles, true, center, range, TARGET_WALK_LIMIT, &id);
+                break;
+            case target_policy_strongest:
+                decided = walk_heap(index, &index->strongest, enemies, handles, center, range, TARGET_WALK_LIMIT, &id);
+                break;
+            case target_policy_weakest:
+                decided = walk_heap(index, &index->weakest, enemies, handles, center, range, TARGET_WALK_LIMIT, &id);
+                break;
+            case target_policy_nearest:
+            case target_policy_count:
+            default:
+                decided = false;
+                break;
+        }
+        if (decided) {
+            return id;
+        }
+    }
+
+    return scan_grid(enemies, grid, bounds, policy, center, range);
+}
@@ -0,0 +1,63 @@
+#ifndef PROJEKT_TARGET_INDEX_H
+#define PROJEKT_TARGET_INDEX_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "game_object.h"
+#include "object_store.h"
+#include "handle_table.h"
+#include "spatial_grid.h"
+#include "enemy.h"
+
+// Enemies on one path with one type share a speed, so within such a lane the
+// earliest spawned is always furthest along and the order never changes
+#define TARGET_LANE_COUNT (PATH_COUNT * enemy_type_count)
+
+// How far a select follows an ordering before scanning the grid instead
+#define TARGET_WALK_LIMIT 32
+
+#define TARGET_NO_SLOT (-1)
+
+typedef struct {
+    float key;
+    uint32_t slot;
+} target_entry;
+
+// Binary min-heap of handle slots; pos maps a listed slot to its entry
+typedef struct {
+    target_entry *entries;
+    uint32_t *pos;
+    size_t count;
+} target_heap;
+
+typedef struct {
+    int32_t head;
+    int32_t tail;
+} target_lane;
+
+// Targetable enemies kept in order as they change instead of re-sorted every
+// tick: a queue per lane, in spawn order, for progress along the path, and a
+// heap each way for health. Everything is indexed by handle slot, so rows
+// moving during compaction leave it untouched.
+typedef struct {
+    int *ids;
+    int32_t *prev;
+    int32_t *next;
+    uint8_t *lane;
+    target_lane lanes[TARGET_LANE_COUNT];
+    target_heap weakest;
+    target_heap strongest;
+    size_t capacity;
+} target_index;
+
+result_code target_index_init(target_index *index, size_t max_slots);
+void target_index_free(target_index *index);
+void target_index_clear(target_index *index);
+void target_index_insert(target_index *index, const enemy_store *enemies, size_t row);
+void target_index_remove(target_index *index, int id);
+void target_index_update_health(target_index *index, int id, float health);
+int target_index_select(const target_index *index, const enemy_store *enemies, const handle_table *handles,
+                        const spatial_grid *grid, tower_target_policy policy, vector2 center, float range);
+
+#endif //PROJEKT_TARGET_INDEX_H
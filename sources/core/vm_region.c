@@ -0,0 +1,112 @@
+#define _DEFAULT_SOURCE
+
+#include "vm_region.h"
+
+#include <stdint.h>
+#include <stdio.h>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define VM_REGION_MMAP 1
+#include <sys/mman.h>
+#include <unistd.h>
+#else
+#define VM_REGION_MMAP 0
+#include <stdlib.h>
+#include <string.h>
+#endif
+
+#if VM_REGION_MMAP
+
+#ifndef MAP_NORESERVE
+#define MAP_NORESERVE 0
+#endif
+
+static size_t page_size(void) {
+    static size_t cached = 0;
+    if (cached == 0) {
+        const long size = sysconf(_SC_PAGESIZE);
+        cached = size > 0 ? (size_t)size : 4096;
+    }
+    return cached;
+}
+
+void *vm_region_reserve(const size_t bytes) {
+    if (bytes == 0) {
+        return nullptr;
+    }
+
+    void *base = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+    return base == MAP_FAILED ? nullptr : base;
+}
+
+void vm_region_release(void *base, const size_t bytes) {
+    if (base == nullptr || bytes == 0) {
+        return;
+    }
+
+    if (munmap(base, bytes) != 0) {
+        fprintf(stderr, "WARNING: Failed to release %zu reserved bytes\n", bytes);
+    }
+}
+
+// Hands whole pages past keep_bytes back to the system; reading them again
+// later gives zeroes
+void vm_region_discard(void *base, const size_t keep_bytes, const size_t bytes) {
+    if (base == nullptr) {
+        return;
+    }
+
+    const size_t page = page_size();
+    const size_t first = (keep_bytes + page - 1) / page * page;
+    if (first >= bytes) {
+        return;
+    }
+
+    madvise((uint8_t *)base + first, bytes - first, MADV_DONTNEED);
+}
+
+size_t vm_resident_bytes(void) {
+    FILE *statm = fopen("/proc/self/statm", "r");
+    if (statm == nullptr) {
+        return VM_RESIDENT_UNKNOWN;
+    }
+
+    unsigned long total_pages = 0;
+    unsigned long resident_pages = 0;
+    const int read = fscanf(statm, "%lu %lu", &total_pages, &resident_pages);
+    fclose(statm);
+
+    return read == 2 ? (size_t)resident_pages * page_size() : VM_RESIDENT_UNKNOWN;
+}
+
+#else
+
+// Without mmap the whole reservation is one zeroed block up front. It is
+// never reallocated, so rows still stay where they are; it just costs the
+// memory for max_capacity from the start.
+void *vm_region_reserve(const size_t bytes) {
+    if (bytes == 0) {
+        return nullptr;
+    }
+
+    return calloc(1, bytes);
+}
+
+void vm_region_release(void *base, const size_t bytes) {
+    (void)bytes;
+    free(base);
+}
+
+void vm_region_discard(void *base, const size_t keep_bytes, const size_t bytes) {
+    if (base == nullptr || keep_bytes >= bytes) {
+        return;
+    }
+
+    memset((uint8_t *)base + keep_bytes, 0, bytes - keep_bytes);
+}
+
+size_t vm_resident_bytes(void) {
+    return VM_RESIDENT_UNKNOWN;
+}
+
+#endif
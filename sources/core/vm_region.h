@@ -0,0 +1,19 @@
+#ifndef PROJEKT_VM_REGION_H
+#define PROJEKT_VM_REGION_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Returned by vm_resident_bytes where the platform does not report it
+#define VM_RESIDENT_UNKNOWN SIZE_MAX
+
+// Address space reserved once for the most a column can ever hold. On Unix
+// pages get memory the first time they are written; elsewhere the region is
+// allocated whole. Either way a column grows in place and the rows already in
+// it never move.
+void *vm_region_reserve(size_t bytes);
+void vm_region_release(void *base, size_t bytes);
+void vm_region_discard(void *base, size_t keep_bytes, size_t bytes);
+size_t vm_resident_bytes(void);
+
+#endif //PROJEKT_VM_REGION_H
@@ -1,4 +1,6 @@
 #include "enemy.h"
+#include "game.h"
+#include "simd_kernels.h"
 #include <stdio.h>
 #include <math.h>
 
@@ -9,7 +11,6 @@ constexpr int flying_fly_frames = 8;
 constexpr int flying_hit_frames = 4;
 constexpr int flying_die_frames = 17;
 constexpr float anim_frame_duration = 0.1f;
-constexpr float waypoint_reached_threshold = 0.01f;
 
 static const vector2 path_0_waypoints[] = {
     {0, 2},
@@ -28,8 +29,64 @@ static const vector2 path_1_waypoints[] = {
 static constexpr int path_0_count = sizeof(path_0_waypoints) / sizeof(path_0_waypoints[0]);
 static constexpr int path_1_count = sizeof(path_1_waypoints) / sizeof(path_1_waypoints[0]);
 
-static const vector2* const paths[] = { path_0_waypoints, path_1_waypoints };
-static constexpr int path_counts[] = { path_0_count, path_1_count };
+static_assert(sizeof(path_0_waypoints) / sizeof(path_0_waypoints[0]) <= MAX_PATH_WAYPOINTS &&
+              sizeof(path_1_waypoints) / sizeof(path_1_waypoints[0]) <= MAX_PATH_WAYPOINTS,
+              "Path has more waypoints than MAX_PATH_WAYPOINTS");
+
+typedef struct {
+    const vector2 *waypoints;
+    int count;
+    float cumulative[MAX_PATH_WAYPOINTS];
+} enemy_path;
+
+// cumulative[i] is the arc length from the start of the path to waypoint i
+static enemy_path paths[PATH_COUNT] = {
+    { .waypoints = path_0_waypoints, .count = path_0_count },
+    { .waypoints = path_1_waypoints, .count = path_1_count }
+};
+
+void init_enemy_paths(void) {
+    for (int p = 0; p < PATH_COUNT; p++) {
+        enemy_path* path = &paths[p];
+        path->cumulative[0] = 0.0f;
+
+        for (int i = 1; i < path->count; i++) {
+            const float dx = path->waypoints[i].x - path->waypoints[i - 1].x;
+            const float dy = path->waypoints[i].y - path->waypoints[i - 1].y;
+            path->cumulative[i] = path->cumulative[i - 1] + sqrtf(dx * dx + dy * dy);
+        }
+    }
+}
+
+float get_path_length(const int path_id) {
+    if (path_id < 0 || path_id >= PATH_COUNT) return 0.0f;
+
+    const enemy_path* path = &paths[path_id];
+    return path->cumulative[path->count - 1];
+}
+
+// segment is the waypoint being walked towards; it only ever moves forward
+static vector2 position_on_path(const enemy_path* path, const float distance, int* segment) {
+    int next = *segment < 1 ? 1 : *segment;
+    while (next < path->count - 1 && distance > path->cumulative[next]) {
+        next++;
+    }
+    *segment = next;
+
+    const vector2 from = path->waypoints[next - 1];
+    const vector2 to = path->waypoints[next];
+    const float length = path->cumulative[next] - path->cumulative[next - 1];
+    const float t = length > 0.0f ? (distance - path->cumulative[next - 1]) / length : 1.0f;
+
+    return (vector2){ from.x + (to.x - from.x) * t, from.y + (to.y - from.y) * t };
+}
+
+vector2 get_path_position(const int path_id, const float distance) {
+    if (path_id < 0 || path_id >= PATH_COUNT) return (vector2){0, 0};
+
+    int segment = 1;
+    return position_on_path(&paths[path_id], distance, &segment);
+}
 
 enemy_stats get_enemy_stats(const enemy_type type) {
     switch (type) {
@@ -65,99 +122,194 @@ int get_enemy_frame_count(const enemy_type type, const enemy_animation_state sta
     }
 }
 
-void update_enemy_animation(game_object* const en, const float delta_time) {
-    if (en == nullptr) return;
+void update_enemy_animation(enemy_store* const enemies, const size_t index, const float delta_time) {
+    if (enemies == nullptr || index >= enemies->count) return;
 
-    en->data.enemy.frame_timer += delta_time;
+    enemies->frame_timer[index] += delta_time;
 
-    if (en->data.enemy.frame_timer >= anim_frame_duration) {
-        en->data.enemy.frame_timer = 0.0f;
-        en->data.enemy.current_frame++;
+    if (enemies->frame_timer[index] >= anim_frame_duration) {
+        enemies->frame_timer[index] = 0.0f;
+        enemies->current_frame[index]++;
 
-        const int max_frames = get_enemy_frame_count(en->data.enemy.type, en->data.enemy.anim_state);
+        const int max_frames = get_enemy_frame_count(enemies->type[index], enemies->anim_state[index]);
 
-        if (en->data.enemy.anim_state == enemy_anim_die) {
-            if (en->data.enemy.current_frame >= max_frames) {
-                en->data.enemy.current_frame = max_frames - 1;
-                en->is_active = false;
-            }
-        } else if (en->data.enemy.anim_state == enemy_anim_hit) {
-            if (en->data.enemy.current_frame >= max_frames) {
-                en->data.enemy.anim_state = enemy_anim_run;
-                en->data.enemy.current_frame = 0;
+        if (enemies->anim_state[index] == enemy_anim_hit) {
+            if (enemies->current_frame[index] >= max_frames) {
+                enemies->anim_state[index] = enemy_anim_run;
+                enemies->current_frame[index] = 0;
             }
         } else {
-            if (en->data.enemy.current_frame >= max_frames) {
-                en->data.enemy.current_frame = 0;
+            if (enemies->current_frame[index] >= max_frames) {
+                enemies->current_frame[index] = 0;
             }
         }
     }
 }
 
-void update_enemy(game_object* const en, const float delta_time) {
-    if (en == nullptr) return;
-
-    if (!en->is_active) {
+// Everything except moving: animation and path validation. Enemies
+// that must stay put have their speed zeroed so the movement kernel can
+// advance every row without branching.
+static void update_enemy_state(enemy_store* const enemies, const size_t i, const float delta_time) {
+    if (!enemies->is_active[i]) {
+        enemies->speed[i] = 0.0f;
         return;
     }
 
-    update_enemy_animation(en, delta_time);
+    update_enemy_animation(enemies, i, delta_time);
 
-    if (en->data.enemy.anim_state == enemy_anim_die) {
-        return;
+    const int path_id = enemies->path_id[i];
+
+    if (path_id < 0 || path_id >= PATH_COUNT) {
+        enemy_store_retire(enemies, i);
+        enemies->speed[i] = 0.0f;
     }
+}
 
-    if (en->data.enemy.health <= 0) {
-        en->data.enemy.anim_state = enemy_anim_die;
-        en->data.enemy.current_frame = 0;
-        en->data.enemy.frame_timer = 0.0f;
+static void place_enemy_on_path(enemy_store* const enemies, const size_t i) {
+    if (!enemies->is_active[i]) {
         return;
     }
 
-    const int path_id = en->data.enemy.path_id;
+    const enemy_path* path = &paths[enemies->path_id[i]];
+    const float length = path->cumulative[path->count - 1];
 
-    if (path_id < 0 || path_id >= 2) {
-        en->is_active = false;
-        return;
+    if (enemies->distance[i] >= length) {
+        enemies->distance[i] = length;
+        enemy_store_retire(enemies, i);
     }
 
-    const int waypoint_count = path_counts[path_id];
-    const vector2* const current_path = paths[path_id];
+    const vector2 position = position_on_path(path, enemies->distance[i], &enemies->waypoint_index[i]);
+    enemies->pos_x[i] = position.x;
+    enemies->pos_y[i] = position.y;
+}
 
-    if (en->data.enemy.waypoint_index >= waypoint_count) {
-        en->is_active = false;
+void update_enemies(enemy_store* const enemies, const float delta_time) {
+    if (enemies == nullptr) return;
+
+    for (size_t i = 0; i < enemies->count; i++) {
+        update_enemy_state(enemies, i, delta_time);
+    }
+
+    simd_advance_distances(enemies->distance, enemies->speed, enemies->count, delta_time);
+
+    for (size_t i = 0; i < enemies->count; i++) {
+        place_enemy_on_path(enemies, i);
+    }
+}
+
+// Path distance of a lazy enemy `fraction` ticks after `tick`; fraction may be
+// negative so the renderer can place it between the last two ticks
+static float lazy_distance(const enemy_store* const enemies, const size_t index,
+                           const uint64_t tick, const float fraction) {
+    const float elapsed = (float)(tick - enemies->spawn_tick[index]) + fraction;
+    const float distance = fmaxf(elapsed, 0.0f) * enemies->speed[index] * SIM_TICK_DURATION;
+    return fminf(distance, get_path_length(enemies->path_id[index]));
+}
+
+vector2 get_lazy_enemy_position(const enemy_store* const enemies, const size_t index,
+                                const uint64_t tick, const float fraction) {
+    return get_path_position(enemies->path_id[index], lazy_distance(enemies, index, tick, fraction));
+}
+
+void get_lazy_enemy_animation(const enemy_store* const enemies, const size_t index, const uint64_t tick,
+                              enemy_animation_state* const state, int* const frame) {
+    const uint64_t ticks_per_frame = sim_ticks_from_seconds(anim_frame_duration);
+    const enemy_type type = enemies->type[index];
+    const uint64_t hit_tick = enemies->hit_tick[index];
+
+    if (hit_tick != ENEMY_NO_HIT_TICK && tick >= hit_tick) {
+        const uint64_t hit_frame = (tick - hit_tick) / ticks_per_frame;
+        if (hit_frame < (uint64_t)get_enemy_frame_count(type, enemy_anim_hit)) {
+            *state = enemy_anim_hit;
+            *frame = (int)hit_frame;
+            return;
+        }
+    }
+
+    const uint64_t run_frames = (uint64_t)get_enemy_frame_count(type, enemy_anim_run);
+    *state = enemy_anim_run;
+    *frame = (int)((tick - enemies->spawn_tick[index]) / ticks_per_frame % run_frames);
+}
+
+void place_lazy_enemy(game *g, const size_t index) {
+    enemy_store* enemies = &g->enemies;
+    const int path_id = enemies->path_id[index];
+    if (path_id < 0 || path_id >= PATH_COUNT) {
         return;
     }
 
-    const vector2 target_pos = current_path[en->data.enemy.waypoint_index];
-    const vector2 direction = {
-        target_pos.x - en->position.x,
-        target_pos.y - en->position.y
-    };
+    enemies->distance[index] = lazy_distance(enemies, index, g->tick, 0.0f);
 
-    const float distance = sqrtf(direction.x * direction.x + direction.y * direction.y);
+    const vector2 position = position_on_path(&paths[path_id], enemies->distance[index],
+                                              &enemies->waypoint_index[index]);
+    enemies->pos_x[index] = position.x;
+    enemies->pos_y[index] = position.y;
 
-    if (distance < waypoint_reached_threshold) {
-        en->position = target_pos;
-        en->data.enemy.waypoint_index++;
-    } else {
-        const float abs_dx = fabsf(direction.x);
-        const float abs_dy = fabsf(direction.y);
-        const float distance_to_move = en->data.enemy.speed * delta_time;
+    get_lazy_enemy_animation(enemies, index, g->tick, &enemies->anim_state[index], &enemies->current_frame[index]);
+}
 
-        if (abs_dx > abs_dy) {
-            if (abs_dx <= distance_to_move) {
-                en->position.x = target_pos.x;
-            } else {
-                en->position.x += (direction.x > 0 ? 1.0f : -1.0f) * distance_to_move;
-            }
-        } else {
-            if (abs_dy <= distance_to_move) {
-                en->position.y = target_pos.y;
-            } else {
-                en->position.y += (direction.y > 0 ? 1.0f : -1.0f) * distance_to_move;
+void place_lazy_enemies(game *g) {
+    if (g == nullptr || !g->lazy_enemies || g->enemies_placed_tick == g->tick) return;
+
+    for (size_t i = 0; i < g->enemies.count; i++) {
+        if (g->enemies.is_active[i]) {
+            place_lazy_enemy(g, i);
+        }
+    }
+    g->enemies_placed_tick = g->tick;
+}
+
+result_code schedule_enemy_exit(game *g, const size_t index) {
+    VALIDATE_PTR_RET(g, result_error_null_ptr);
+
+    enemy_store* enemies = &g->enemies;
+    const int path_id = enemies->path_id[index];
+
+    if (path_id < 0 || path_id >= PATH_COUNT) {
+        enemy_store_retire(enemies, index);
+        return result_ok;
+    }
+
+    const float step = enemies->speed[index] * SIM_TICK_DURATION;
+    if (step <= 0.0f) {
+        return result_ok;
+    }
+
+    // Same tick the integrating update would first reach the end of the path
+    const uint64_t walk_ticks = (uint64_t)ceilf(get_path_length(path_id) / step);
+    return event_heap_push(&g->enemy_exits, enemies->spawn_tick[index] + walk_ticks, enemies->ids[index]);
+}
+
+void update_lazy_enemies(game *g) {
+    if (g == nullptr) return;
+
+    scheduled_event event;
+    while (event_heap_pop_due(&g->enemy_exits, g->tick, &event)) {
+        const int index = handle_table_resolve(&g->handles, event.id, enemy);
+        if (index >= 0) {
+            enemy_store_retire(&g->enemies, index);
+        }
+    }
+}
+
+void update_death_fx(fx_pool* const pool, const float delta_time) {
+    if (pool == nullptr) return;
+
+    size_t i = 0;
+    while (i < pool->count) {
+        death_fx* fx = &pool->effects[i];
+
+        fx->frame_timer += delta_time;
+        if (fx->frame_timer >= anim_frame_duration) {
+            fx->frame_timer = 0.0f;
+            fx->frame++;
+
+            if (fx->frame >= get_enemy_frame_count(fx->anim, enemy_anim_die)) {
+                fx_pool_remove(pool, i);
+                continue;
             }
         }
+        i++;
     }
 }
 
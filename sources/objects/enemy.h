@@ -2,6 +2,14 @@
 #define PROJEKT_ENEMY_H
 
 #include "game_object.h"
+#include "object_store.h"
+#include "fx_pool.h"
+
+typedef struct game game;
+
+#define PATH_COUNT 2
+#define MAX_PATH_WAYPOINTS 8
+#define ENEMY_NO_HIT_TICK UINT64_MAX
 
 typedef struct {
     float health;
@@ -10,10 +18,21 @@ typedef struct {
 } enemy_stats;
 
 enemy_stats get_enemy_stats(enemy_type type);
-void update_enemy(game_object*en, float delta_time);
+void update_enemies(enemy_store *enemies, float delta_time);
 sprite_info get_enemy_sprites(enemy_type type, enemy_animation_state state);
 int get_enemy_frame_count(enemy_type type, enemy_animation_state state);
-void update_enemy_animation(game_object*en, float delta_time);
+void update_enemy_animation(enemy_store *enemies, size_t index, float delta_time);
+void update_death_fx(fx_pool *pool, float delta_time);
+vector2 get_lazy_enemy_position(const enemy_store *enemies, size_t index, uint64_t tick, float fraction);
+void get_lazy_enemy_animation(const enemy_store *enemies, size_t index, uint64_t tick,
+                              enemy_animation_state *state, int *frame);
+void place_lazy_enemy(game *g, size_t index);
+void place_lazy_enemies(game *g);
+result_code schedule_enemy_exit(game *g, size_t index);
+void update_lazy_enemies(game *g);
 vector2 get_path_start_position(int path_id);
+void init_enemy_paths(void);
+float get_path_length(int path_id);
+vector2 get_path_position(int path_id, float distance);
 
 #endif
@@ -4,11 +4,12 @@
 
 #include "projectile.h"
 #include "game.h"
+#include "enemy.h"
 #include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
 
-#define PROJECTILE_SPEED 10.0f
-#define ICEBALL_FRAMES 10
-#define ICEBALL_FRAME_DURATION 0.05f
+#define INTERCEPT_ITERATIONS 4
 
 game_object create_projectile(const vector2 start_pos, const vector2 target_pos, const float damage, const int owner_id, const int target_id) {
     vector2 direction = {
@@ -43,110 +44,297 @@ game_object create_projectile(const vector2 start_pos, const vector2 target_pos,
     };
 }
 
-void update_projectile(const game *g, game_object *proj, const float delta_time) {
-    if (g == nullptr || proj == nullptr || g->game_objects == nullptr) return;
+static void apply_projectile_hit(game *g, const size_t enemy_index, const float damage) {
+    enemy_store* enemies = &g->enemies;
+    enemies->health[enemy_index] -= damage;
 
-    if (!proj->is_active) {
+    if (enemies->health[enemy_index] <= 0) {
+        defeat_enemy(g, enemy_index);
         return;
     }
 
-    proj->data.projectile.frame_timer += delta_time;
-    if (proj->data.projectile.frame_timer >= ICEBALL_FRAME_DURATION) {
-        proj->data.projectile.frame_timer = 0.0f;
-        constexpr int max_frames = ICEBALL_FRAMES;
-        proj->data.projectile.current_frame = (proj->data.projectile.current_frame + 1) % max_frames;
+    target_index_update_health(&g->targets, enemies->ids[enemy_index], enemies->health[enemy_index]);
+
+    enemies->anim_state[enemy_index] = enemy_anim_hit;
+    enemies->current_frame[enemy_index] = 0;
+    enemies->frame_timer[enemy_index] = 0.0f;
+    enemies->hit_tick[enemy_index] = g->tick;
+}
+
+// Squared distance from a point to the segment start + t * step, with t in
+// [0, 1] written to out_t so callers can pick the earliest of several hits
+static float swept_distance_sq(const float start_x, const float start_y, const float step_x, const float step_y,
+                               const float point_x, const float point_y, float *out_t) {
+    const float to_x = point_x - start_x;
+    const float to_y = point_y - start_y;
+    const float step_sq = step_x * step_x + step_y * step_y;
+
+    float t = 0.0f;
+    if (step_sq > 0.000001f) {
+        t = fminf(fmaxf((to_x * step_x + to_y * step_y) / step_sq, 0.0f), 1.0f);
     }
 
-    const int target_id = proj->data.projectile.target_id;
-    game_object* target = nullptr;
+    const float dx = to_x - step_x * t;
+    const float dy = to_y - step_y * t;
+    *out_t = t;
+    return dx * dx + dy * dy;
+}
 
-    for (size_t i = 0; i < g->object_count; i++) {
-        game_object* obj = &g->game_objects[i];
+static void update_projectile(game *g, const size_t index, const float delta_time) {
+    projectile_store* projectiles = &g->projectiles;
+    enemy_store* enemies = &g->enemies;
 
-        if (obj->type != enemy || obj->id != target_id) {
-            continue;
-        }
+    if (!projectiles->is_active[index]) {
+        return;
+    }
 
-        if (obj->is_active && obj->data.enemy.anim_state != enemy_anim_die) {
-            target = obj;
-            break;
-        }
+    projectiles->frame_timer[index] += delta_time;
+    if (projectiles->frame_timer[index] >= ICEBALL_FRAME_DURATION) {
+        projectiles->frame_timer[index] = 0.0f;
+        constexpr int max_frames = ICEBALL_FRAMES;
+        projectiles->current_frame[index] = (projectiles->current_frame[index] + 1) % max_frames;
     }
 
-    if (target != nullptr) {
-        const float dx = target->position.x - proj->position.x;
-        const float dy = target->position.y - proj->position.y;
+    const int target_id = projectiles->target_id[index];
+    const int resolved = handle_table_resolve(&g->handles, target_id, enemy);
+    const size_t target = resolved < 0 ? 0 : (size_t)resolved;
+
+    const bool has_target = resolved >= 0 && enemies->is_active[target];
+
+    if (has_target) {
+        const float dx = enemies->pos_x[target] - projectiles->pos_x[index];
+        const float dy = enemies->pos_y[target] - projectiles->pos_y[index];
 
         const float length = sqrtf(dx * dx + dy * dy);
         if (length > 0.001f) {
             const float inv_length = 1.0f / length;
-            proj->data.projectile.velocity.x = dx * inv_length * PROJECTILE_SPEED;
-            proj->data.projectile.velocity.y = dy * inv_length * PROJECTILE_SPEED;
+            projectiles->vel_x[index] = dx * inv_length * PROJECTILE_SPEED;
+            projectiles->vel_y[index] = dy * inv_length * PROJECTILE_SPEED;
         }
     }
 
-    proj->position.x += proj->data.projectile.velocity.x * delta_time;
-    proj->position.y += proj->data.projectile.velocity.y * delta_time;
+    const float start_x = projectiles->pos_x[index];
+    const float start_y = projectiles->pos_y[index];
+    const float step_x = projectiles->vel_x[index] * delta_time;
+    const float step_y = projectiles->vel_y[index] * delta_time;
 
-    constexpr float max_x = 26.0f;
-    constexpr float max_y = 20.0f;
-    constexpr float min_pos = -2.0f;
+    projectiles->pos_x[index] = start_x + step_x;
+    projectiles->pos_y[index] = start_y + step_y;
+
+    constexpr float collision_dist_sq = 1.0f;
+    float hit_t;
 
-    if (proj->position.x < min_pos || proj->position.x > max_x ||
-        proj->position.y < min_pos || proj->position.y > max_y) {
-        proj->is_active = false;
+    if (has_target &&
+        swept_distance_sq(start_x, start_y, step_x, step_y,
+                          enemies->pos_x[target], enemies->pos_y[target], &hit_t) < collision_dist_sq) {
+        apply_projectile_hit(g, target, projectiles->damage[index]);
+        projectile_store_retire(projectiles, index);
         return;
     }
 
-    constexpr float collision_dist_sq = 1.0f;
+    // Test everything the projectile passed on its way, not just where it stopped,
+    // so fast projectiles or long ticks cannot skip over an enemy
+    const spatial_grid* grid = &g->enemy_grid;
+    const grid_bounds from = spatial_grid_query_bounds(grid, start_x, start_y, 1.0f);
+    const grid_bounds to = spatial_grid_query_bounds(grid, start_x + step_x, start_y + step_y, 1.0f);
+    const grid_bounds bounds = {
+        .min_x = from.min_x < to.min_x ? from.min_x : to.min_x,
+        .min_y = from.min_y < to.min_y ? from.min_y : to.min_y,
+        .max_x = from.max_x > to.max_x ? from.max_x : to.max_x,
+        .max_y = from.max_y > to.max_y ? from.max_y : to.max_y
+    };
+
+    // Circle around the whole sweep; most candidates fail this cheaper test
+    const float mid_x = start_x + step_x * 0.5f;
+    const float mid_y = start_y + step_y * 0.5f;
+    const float reach = 1.0f + 0.5f * sqrtf(step_x * step_x + step_y * step_y);
+    const float reach_sq = reach * reach;
 
-    if (target != nullptr) {
-        const float dx = target->position.x - proj->position.x;
-        const float dy = target->position.y - proj->position.y;
+    int hit = -1;
+    float earliest_t = 2.0f;
 
-        if (dx * dx + dy * dy < collision_dist_sq) {
-            target->data.enemy.health -= proj->data.projectile.damage;
+    for (int cy = bounds.min_y; cy <= bounds.max_y; cy++) {
+        const uint32_t begin = grid->cell_start[spatial_grid_cell(grid, bounds.min_x, cy)];
+        const uint32_t end = grid->cell_start[spatial_grid_cell(grid, bounds.max_x, cy) + 1];
 
-            if (target->data.enemy.health > 0) {
-                target->data.enemy.anim_state = enemy_anim_hit;
-                target->data.enemy.current_frame = 0;
-                target->data.enemy.frame_timer = 0.0f;
+        for (uint32_t k = begin; k < end; k++) {
+            const float mx = grid->item_x[k] - mid_x;
+            const float my = grid->item_y[k] - mid_y;
+            if (mx * mx + my * my >= reach_sq) {
+                continue;
             }
 
-            proj->is_active = false;
-            return;
+            const float dist_sq = swept_distance_sq(start_x, start_y, step_x, step_y,
+                                                    grid->item_x[k], grid->item_y[k], &hit_t);
+            if (dist_sq >= collision_dist_sq || hit_t >= earliest_t) {
+                continue;
+            }
+
+            // Enemies killed earlier this tick are still in the grid
+            const uint32_t i = grid->items[k];
+            if (!enemies->is_active[i] || enemies->ids[i] == target_id) {
+                continue;
+            }
+
+            hit = (int)i;
+            earliest_t = hit_t;
         }
     }
 
-    for (size_t i = 0; i < g->object_count; i++) {
-        game_object* obj = &g->game_objects[i];
+    if (hit >= 0) {
+        apply_projectile_hit(g, (size_t)hit, projectiles->damage[index]);
+        projectile_store_retire(projectiles, index);
+        return;
+    }
+
+    constexpr float max_x = 26.0f;
+    constexpr float max_y = 20.0f;
+    constexpr float min_pos = -2.0f;
 
-        if (obj->type != enemy || !obj->is_active || obj->data.enemy.anim_state == enemy_anim_die) {
-            continue;
+    const float pos_x = projectiles->pos_x[index];
+    const float pos_y = projectiles->pos_y[index];
+
+    if (pos_x < min_pos || pos_x > max_x || pos_y < min_pos || pos_y > max_y) {
+        projectile_store_retire(projectiles, index);
+    }
+}
+
+void update_projectiles(game *g, const float delta_time) {
+    if (g == nullptr) return;
+
+    for (size_t i = 0; i < g->projectiles.count; i++) {
+        update_projectile(g, i, delta_time);
+    }
+}
+
+result_code impact_schedule_init(impact_schedule *schedule, const size_t capacity) {
+    VALIDATE_PTR_RET(schedule, result_error_null_ptr);
+
+    *schedule = (impact_schedule){0};
+    schedule->impacts = malloc(sizeof(impact) * capacity);
+    schedule->free_slots = malloc(sizeof(uint32_t) * capacity);
+    if (schedule->impacts == nullptr || schedule->free_slots == nullptr) {
+        return result_error_out_of_memory;
+    }
+    schedule->capacity = capacity;
+
+    return event_heap_init(&schedule->pending, capacity);
+}
+
+void impact_schedule_free(impact_schedule *schedule) {
+    VALIDATE_PTR(schedule);
+
+    event_heap_free(&schedule->pending);
+    free(schedule->impacts);
+    free(schedule->free_slots);
+    *schedule = (impact_schedule){0};
+}
+
+void impact_schedule_clear(impact_schedule *schedule) {
+    VALIDATE_PTR(schedule);
+
+    event_heap_clear(&schedule->pending);
+    schedule->count = 0;
+    schedule->free_count = 0;
+}
+
+static result_code acquire_impact_slot(impact_schedule *schedule, size_t *out_slot) {
+    if (schedule->free_count > 0) {
+        *out_slot = schedule->free_slots[--schedule->free_count];
+        return result_ok;
+    }
+
+    if (schedule->count == schedule->capacity) {
+        const size_t new_capacity = schedule->capacity == 0 ? STARTING_COUNT_OF_GAME_OBJECTS : schedule->capacity * 2;
+
+        impact *impacts = realloc(schedule->impacts, sizeof(impact) * new_capacity);
+        if (impacts == nullptr) {
+            return result_error_out_of_memory;
         }
+        schedule->impacts = impacts;
 
-        if (obj->id == target_id) {
-            continue;
+        uint32_t *free_slots = realloc(schedule->free_slots, sizeof(uint32_t) * new_capacity);
+        if (free_slots == nullptr) {
+            return result_error_out_of_memory;
         }
+        schedule->free_slots = free_slots;
+        schedule->capacity = new_capacity;
+    }
+
+    *out_slot = schedule->count++;
+    return result_ok;
+}
 
-        const float dx = obj->position.x - proj->position.x;
-        const float dy = obj->position.y - proj->position.y;
+result_code schedule_impact(game *g, const vector2 start_pos, const float damage, const int target_id) {
+    VALIDATE_PTR_RET(g, result_error_null_ptr);
 
-        if (fabsf(dx) > 1.0f || fabsf(dy) > 1.0f) {
-            continue;
-        }
+    const enemy_store* enemies = &g->enemies;
+    const int resolved = handle_table_resolve(&g->handles, target_id, enemy);
+    if (resolved < 0) {
+        return result_error_invalid_state;
+    }
+    const size_t target = (size_t)resolved;
 
-        if (dx * dx + dy * dy < collision_dist_sq) {
-            obj->data.enemy.health -= proj->data.projectile.damage;
+    // Enemies keep a constant speed along their path, so while they are slower
+    // than the iceball each pass moves the meeting point closer to the real one
+    vector2 impact_pos = {enemies->pos_x[target], enemies->pos_y[target]};
+    uint64_t flight_ticks = 1;
 
-            if (obj->data.enemy.health > 0) {
-                obj->data.enemy.anim_state = enemy_anim_hit;
-                obj->data.enemy.current_frame = 0;
-                obj->data.enemy.frame_timer = 0.0f;
-            }
+    for (int i = 0; i < INTERCEPT_ITERATIONS; i++) {
+        const float dx = impact_pos.x - start_pos.x;
+        const float dy = impact_pos.y - start_pos.y;
+
+        flight_ticks = sim_ticks_from_seconds(sqrtf(dx * dx + dy * dy) / PROJECTILE_SPEED);
+        impact_pos = get_path_position(enemies->path_id[target],
+                                       enemies->distance[target] +
+                                       enemies->speed[target] * (float)flight_ticks * SIM_TICK_DURATION);
+    }
+
+    impact_schedule* schedule = &g->impacts;
+    size_t slot;
+    const result_code res = acquire_impact_slot(schedule, &slot);
+    if (res != result_ok) {
+        return res;
+    }
+
+    // The slot is only filled once its event is queued; otherwise it goes back
+    // unused so the renderer never sees a shot that will not land
+    const result_code push_res = event_heap_push(&schedule->pending, g->tick + flight_ticks, (int)slot);
+    if (push_res != result_ok) {
+        schedule->impacts[slot].in_flight = false;
+        schedule->free_slots[schedule->free_count++] = (uint32_t)slot;
+        return push_res;
+    }
+
+    schedule->impacts[slot] = (impact) {
+        .from = start_pos,
+        .to = impact_pos,
+        .fire_tick = g->tick,
+        .impact_tick = g->tick + flight_ticks,
+        .damage = damage,
+        .target_id = target_id,
+        .in_flight = true
+    };
+
+    return result_ok;
+}
 
-            proj->is_active = false;
-            return;
+void update_impacts(game *g) {
+    if (g == nullptr) return;
+
+    impact_schedule* schedule = &g->impacts;
+    enemy_store* enemies = &g->enemies;
+
+    scheduled_event event;
+    while (event_heap_pop_due(&schedule->pending, g->tick, &event)) {
+        impact* shot = &schedule->impacts[event.id];
+        const int target = handle_table_resolve(&g->handles, shot->target_id, enemy);
+
+        if (target >= 0 && enemies->is_active[target]) {
+            apply_projectile_hit(g, (size_t)target, shot->damage);
         }
+
+        shot->in_flight = false;
+        schedule->free_slots[schedule->free_count++] = (uint32_t)event.id;
     }
 }
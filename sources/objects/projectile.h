@@ -5,12 +5,49 @@
 #ifndef PROJEKT_PROJECTILE_H
 #define PROJEKT_PROJECTILE_H
 
+#include <stddef.h>
+#include <stdint.h>
+
 #include "game_object.h"
+#include "event_heap.h"
+
+#define PROJECTILE_SPEED 10.0f
+#define ICEBALL_FRAMES 10
+#define ICEBALL_FRAME_DURATION 0.05f
 
 typedef struct game game;
 
+// A shot whose hit was worked out when it was fired. The record is also the
+// iceball drawn in flight; nothing about it is simulated.
+typedef struct {
+    vector2 from;
+    vector2 to;
+    uint64_t fire_tick;
+    uint64_t impact_tick;
+    float damage;
+    int target_id;
+    bool in_flight;
+} impact;
+
+// Analytic shots wait in the heap, keyed by the tick their damage lands on
+typedef struct {
+    event_heap pending;
+    impact *impacts;
+    uint32_t *free_slots;
+    size_t free_count;
+    size_t count;
+    size_t capacity;
+} impact_schedule;
+
 game_object create_projectile(vector2 start_pos, vector2 target_pos, float damage, int owner_id, int target_id);
 
-void update_projectile(const game *g, game_object *proj, float delta_time);
+void update_projectiles(game *g, float delta_time);
+
+result_code impact_schedule_init(impact_schedule *schedule, size_t capacity);
+void impact_schedule_free(impact_schedule *schedule);
+void impact_schedule_clear(impact_schedule *schedule);
+
+result_code schedule_impact(game *g, vector2 start_pos, float damage, int target_id);
+void update_impacts(game *g);
 
 #endif //PROJEKT_PROJECTILE_H
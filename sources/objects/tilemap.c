@@ -1,4 +1,5 @@
 #include "tilemap.h"
+#include "raylib.h"
 #include <string.h>
 #include <stdio.h>
 #include <stdlib.h>
@@ -51,19 +52,23 @@ static const int l_new_layer_2[MAP_HEIGHT][MAP_WIDTH] = {
    {0,0,66,67,68,0,0,0,0,0,0,0,0,0,69,70,71,0,0,0,66,67,68,0,0}
 };
 
-tile_map init_tilemap() {
+tile_map init_tilemap(const texture_2d tileset1, const texture_2d tileset2) {
     tile_map map;
     map.tile_size = TILE_SIZE;
     map.map_width = MAP_WIDTH;
     map.map_height = MAP_HEIGHT;
+    map.baked = (texture_2d){0};
+    map.baked_scale = 0;
+    map.baked_resets = 0;
+    map.bake_unsupported = false;
 
-    map.tileset1 = load_texture(ASSETS_PATH "images/83291578-f8ec-4e3f-2f6a-6a248efa5800.png");
+    map.tileset1 = tileset1;
     if (map.tileset1.id == 0) {
         fprintf(stderr, "ERROR: Failed to load tileset1 texture\n");
         exit(1);
     }
 
-    map.tileset2 = load_texture(ASSETS_PATH "images/bb5eb52a-6c5d-4e83-72e7-a62c7ac8ea00.png");
+    map.tileset2 = tileset2;
     if (map.tileset2.id == 0) {
         fprintf(stderr, "ERROR: Failed to load tileset2 texture\n");
         exit(1);
@@ -75,20 +80,6 @@ tile_map init_tilemap() {
     return map;
 }
 
-static void draw_layer(const tile_map* map, const int layer[MAP_HEIGHT][MAP_WIDTH], const texture_2d tileset) {
-
-    for (int y = 0; y < map->map_height; y++) {
-        for (int x = 0; x < map->map_width; x++) {
-            int tile_index = layer[y][x];
-
-            if (tile_index == 0) continue;
-
-            tile_index -= 1;
-
-            draw_texture(map,tileset,tile_index,x,y);
-        }
-    }
-}
 static int tiles_per_row(const tile_map* map, const texture_2d tileset) {
     if (map->tile_size == 0) {
         return 0;
@@ -96,16 +87,8 @@ static int tiles_per_row(const tile_map* map, const texture_2d tileset) {
     return (tileset.width + map->tile_size - 1) / map->tile_size;
 }
 
-void draw_texture(const tile_map* map, const texture_2d tileset, const int tile_index, const int x, const int y) {
-
-    const int scaled_tile_size = get_tile_scale(map);
-
-    const int tiles_per_row_v = tiles_per_row(map,tileset);
-    if (tiles_per_row_v == 0) {
-        fprintf(stderr, "ERROR: Failed to count tiles per row\n");
-        return;
-    }
-
+static void draw_tile(const tile_map* map, const texture_2d tileset, const int tiles_per_row_v,
+                      const int scaled_tile_size, const int tile_index, const int x, const int y) {
     const int src_x = tile_index % tiles_per_row_v * map->tile_size;
     const int src_y = tile_index / tiles_per_row_v * map->tile_size;
 
@@ -126,14 +109,81 @@ void draw_texture(const tile_map* map, const texture_2d tileset, const int tile_
     draw_texture_pro(tileset, source, dest, (vector2){0, 0}, 0.0f, white);
 }
 
-void draw_tilemap(const tile_map* map) {
-    draw_layer(map, map->layer1, map->tileset1);
-    draw_layer(map, map->layer2, map->tileset2);
+static void draw_layer(const tile_map* map, const int layer[MAP_HEIGHT][MAP_WIDTH], const texture_2d tileset,
+                       const int scaled_tile_size) {
+    const int tiles_per_row_v = tiles_per_row(map, tileset);
+    if (tiles_per_row_v == 0) {
+        fprintf(stderr, "ERROR: Failed to count tiles per row\n");
+        return;
+    }
+
+    for (int y = 0; y < map->map_height; y++) {
+        for (int x = 0; x < map->map_width; x++) {
+            const int tile_index = layer[y][x];
+
+            if (tile_index == 0) continue;
+
+            draw_tile(map, tileset, tiles_per_row_v, scaled_tile_size, tile_index - 1, x, y);
+        }
+    }
+}
+
+void draw_texture(const tile_map* map, const texture_2d tileset, const int tile_index, const int x, const int y) {
+    const int tiles_per_row_v = tiles_per_row(map, tileset);
+    if (tiles_per_row_v == 0) {
+        fprintf(stderr, "ERROR: Failed to count tiles per row\n");
+        return;
+    }
+
+    draw_tile(map, tileset, tiles_per_row_v, get_tile_scale(map), tile_index, x, y);
+}
+
+static void draw_layers(const tile_map* map, const int scaled_tile_size) {
+    draw_layer(map, map->layer1, map->tileset1, scaled_tile_size);
+    draw_layer(map, map->layer2, map->tileset2, scaled_tile_size);
+}
+
+// A renderer without render target support falls back to drawing every tile
+static bool bake_tilemap(tile_map* map, const int scaled_tile_size) {
+    const int width = map->map_width * scaled_tile_size;
+    const int height = map->map_height * scaled_tile_size;
+
+    if (map->baked.id == 0 || map->baked.width != width || map->baked.height != height) {
+        unload_texture(map->baked);
+        map->baked = load_render_texture(width, height);
+    }
+
+    if (!begin_texture_mode(map->baked)) {
+        map->bake_unsupported = true;
+        return false;
+    }
+    draw_layers(map, scaled_tile_size);
+    end_texture_mode();
+
+    map->baked_scale = scaled_tile_size;
+    map->baked_resets = get_render_target_resets();
+    return true;
+}
+
+// The baked map depends only on the tile scale, so resizes that keep the
+// scale reuse it
+void draw_tilemap(tile_map* map) {
+    const int scaled_tile_size = get_tile_scale(map);
+
+    const bool stale = map->baked.id == 0 || map->baked_scale != scaled_tile_size ||
+                       map->baked_resets != get_render_target_resets();
+    if (map->bake_unsupported || (stale && !bake_tilemap(map, scaled_tile_size))) {
+        draw_layers(map, scaled_tile_size);
+        return;
+    }
+
+    const rectangle bounds = {0, 0, (float)map->baked.width, (float)map->baked.height};
+    draw_texture_pro(map->baked, bounds, bounds, (vector2){0, 0}, 0.0f, white);
 }
 
+// The tilesets belong to the caller's texture atlas
 void unload_tilemap(const tile_map* map) {
-    unload_texture(map->tileset1);
-    unload_texture(map->tileset2);
+    unload_texture(map->baked);
 }
 int get_tile_scale(const tile_map* map) {
     const int screen_width = get_screen_width();
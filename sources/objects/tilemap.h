@@ -1,12 +1,15 @@
 #ifndef TILEMAP_H
 #define TILEMAP_H
 
-#include "raylib.h"
+#include "raylib_types.h"
 
 #define TILE_SIZE 16
 #define MAP_WIDTH 25
 #define MAP_HEIGHT 20
 
+#define TILESET1_PATH ASSETS_PATH "images/83291578-f8ec-4e3f-2f6a-6a248efa5800.png"
+#define TILESET2_PATH ASSETS_PATH "images/bb5eb52a-6c5d-4e83-72e7-a62c7ac8ea00.png"
+
 typedef struct {
     int layer1[MAP_HEIGHT][MAP_WIDTH];
     int layer2[MAP_HEIGHT][MAP_WIDTH];
@@ -15,11 +18,18 @@ typedef struct {
     int tile_size;
     int map_width;
     int map_height;
+
+    // Both layers drawn once at baked_scale; redrawn when the tile scale
+    // changes or the renderer loses its render targets
+    texture_2d baked;
+    int baked_scale;
+    int baked_resets;
+    bool bake_unsupported;
 } tile_map;
 
 // Function declarations
-tile_map init_tilemap();
-void draw_tilemap(const tile_map* map);
+tile_map init_tilemap(texture_2d tileset1, texture_2d tileset2);
+void draw_tilemap(tile_map* map);
 void unload_tilemap(const tile_map* map);
 int get_tile_scale(const tile_map* map);
 void draw_texture(const tile_map* map, texture_2d tileset, int tile_index, int x, int y);
@@ -5,10 +5,53 @@
 #include "tower.h"
 #include "game.h"
 #include "projectile.h"
+#include "simd_kernels.h"
 #include <stdio.h>
+#include <stdlib.h>
 
 typedef game game;
 
+result_code tower_schedule_init(tower_schedule *schedule, const size_t capacity) {
+    VALIDATE_PTR_RET(schedule, result_error_null_ptr);
+
+    *schedule = (tower_schedule){0};
+    schedule->ready = malloc(sizeof(int) * capacity);
+    if (schedule->ready == nullptr) {
+        return result_error_out_of_memory;
+    }
+    schedule->ready_capacity = capacity;
+
+    return event_heap_init(&schedule->reloading, capacity);
+}
+
+void tower_schedule_free(tower_schedule *schedule) {
+    VALIDATE_PTR(schedule);
+
+    event_heap_free(&schedule->reloading);
+    free(schedule->ready);
+    *schedule = (tower_schedule){0};
+}
+
+static result_code push_ready_tower(tower_schedule *schedule, const int id) {
+    if (schedule->ready_count == schedule->ready_capacity) {
+        const size_t new_capacity = schedule->ready_capacity == 0 ? STARTING_COUNT_OF_GAME_OBJECTS : schedule->ready_capacity * 2;
+        int *ready = realloc(schedule->ready, sizeof(int) * new_capacity);
+        if (ready == nullptr) {
+            return result_error_out_of_memory;
+        }
+        schedule->ready = ready;
+        schedule->ready_capacity = new_capacity;
+    }
+
+    schedule->ready[schedule->ready_count++] = id;
+    return result_ok;
+}
+
+static result_code schedule_next_shot(game *g, const size_t index) {
+    const uint64_t due_tick = g->tick + sim_ticks_from_seconds(g->towers.fire_cooldown[index]);
+    return event_heap_push(&g->tower_schedule.reloading, due_tick, g->towers.ids[index]);
+}
+
 game_object init_tower(const vector2 position) {
     return (game_object) {
         .type = tower,
@@ -22,54 +65,83 @@ game_object init_tower(const vector2 position) {
             .width = TOWER_LEVEL_0_WIDTH,
             .height = TOWER_LEVEL_0_HEIGHT,
             .upgrade_cost = TOWER_LEVEL_0_UPGRADE_COST,
-            .level = level_0
+            .level = level_0,
+            .fire_mode = TOWER_DEFAULT_FIRE_MODE,
+            .target_policy = TOWER_DEFAULT_TARGET_POLICY
         }
     };
 }
 
 upgrade_result upgrade_clicked_tower(game *g, const grid_coord coord) {
-    if (g == nullptr || g->game_objects == nullptr) {
+    if (g == nullptr) {
         return upgrade_not_found;
     }
 
-    for (size_t i = 0; i < g->object_count; i++) {
-        if (g->game_objects[i].type != tower) {
-            continue;
-        }
-        game_object* twr = &g->game_objects[i];
+    const int index = find_tower_at_grid(g, coord);
+    if (index < 0) {
+        return upgrade_not_found;
+    }
+
+    return upgrade_tower(g, (size_t)index);
+}
 
-        const int tower_grid_x = (int)twr->position.x;
-        const int tower_grid_y = (int)twr->position.y;
-        const int tower_width  = twr->data.tower.width;
-        const int tower_height = twr->data.tower.height;
+upgrade_result upgrade_tower(game *g, const size_t i) {
+    if (g == nullptr || i >= g->towers.count) {
+        return upgrade_not_found;
+    }
 
-        const bool is_inside = coord.x >= tower_grid_x &&
-                               coord.x < tower_grid_x + tower_width &&
-                               coord.y >= tower_grid_y &&
-                               coord.y < tower_grid_y + tower_height;
+    tower_store* towers = &g->towers;
 
-        if (is_inside) {
-            if (twr->data.tower.level >= level_1) {
-                return upgrade_max_level;
-            }
+    if (towers->level[i] >= level_1) {
+        return upgrade_max_level;
+    }
 
-            if (g->player_money < twr->data.tower.upgrade_cost) {
-                return upgrade_insufficient_funds;
-            }
+    if (g->player_money < towers->upgrade_cost[i]) {
+        return upgrade_insufficient_funds;
+    }
 
-            twr->data.tower.level++;
-            g->player_money -= twr->data.tower.upgrade_cost;
+    towers->level[i]++;
+    g->player_money -= towers->upgrade_cost[i];
 
-            if (twr->data.tower.level == level_1) {
-                twr->data.tower.damage = TOWER_LEVEL_1_DAMAGE;
-                twr->data.tower.range = TOWER_LEVEL_1_RANGE;
-                twr->data.tower.fire_cooldown = TOWER_LEVEL_1_FIRE_COOLDOWN;
-            }
+    if (towers->level[i] == level_1) {
+        towers->damage[i] = TOWER_LEVEL_1_DAMAGE;
+        towers->range[i] = TOWER_LEVEL_1_RANGE;
+        towers->fire_cooldown[i] = TOWER_LEVEL_1_FIRE_COOLDOWN;
 
-            return upgrade_success;
+        if (schedule_next_shot(g, i) != result_ok) {
+            fprintf(stderr, "ERROR: Failed to schedule upgraded tower\n");
         }
     }
-    return upgrade_not_found;
+
+    return upgrade_success;
+}
+
+bool cycle_clicked_tower_policy(game *g, const grid_coord coord) {
+    if (g == nullptr) {
+        return false;
+    }
+
+    const int index = find_tower_at_grid(g, coord);
+    if (index < 0) {
+        return false;
+    }
+
+    tower_store* towers = &g->towers;
+    towers->target_policy[index] = (tower_target_policy)((towers->target_policy[index] + 1) % target_policy_count);
+    towers->target_id[index] = INVALID_HANDLE;
+    return true;
+}
+
+const char* get_target_policy_name(const tower_target_policy policy) {
+    switch (policy) {
+        case target_policy_nearest: return "Nearest";
+        case target_policy_first: return "First";
+        case target_policy_last: return "Last";
+        case target_policy_strongest: return "Strongest";
+        case target_policy_weakest: return "Weakest";
+        case target_policy_count:
+        default: return "Unknown";
+    }
 }
 
 sprite_info get_tower_sprites(const tower_level level) {
@@ -108,83 +180,151 @@ sprite_info get_tower_sprites(const tower_level level) {
 }
 
 int find_nearest_enemy_in_range(const game *g, const vector2 tower_pos, const float range) {
-    if (g == nullptr || g->game_objects == nullptr) {
+    if (g == nullptr) {
         return -1;
     }
 
+    const enemy_store* enemies = &g->enemies;
+    const spatial_grid* grid = &g->enemy_grid;
+
     int nearest_id = -1;
     float nearest_dist_sq = range * range;
 
     const vector2 tower_center = {tower_pos.x + 2.0f, tower_pos.y + 2.0f};
+    const grid_bounds bounds = spatial_grid_query_bounds(grid, tower_center.x, tower_center.y, range);
 
-    for (size_t i = 0; i < g->object_count; i++) {
-        const game_object* obj = &g->game_objects[i];
+    for (int cy = bounds.min_y; cy <= bounds.max_y; cy++) {
+        const uint32_t begin = grid->cell_start[spatial_grid_cell(grid, bounds.min_x, cy)];
+        const uint32_t end = grid->cell_start[spatial_grid_cell(grid, bounds.max_x, cy) + 1];
 
-        if (obj->type != enemy || !obj->is_active) {
-            continue;
+        const int nearest = simd_nearest_point(grid->item_x + begin, grid->item_y + begin, end - begin,
+                                               tower_center.x, tower_center.y, &nearest_dist_sq);
+        if (nearest >= 0) {
+            nearest_id = enemies->ids[grid->items[begin + (uint32_t)nearest]];
         }
+    }
 
-        if (obj->data.enemy.anim_state == enemy_anim_die) {
-            continue;
-        }
+    return nearest_id;
+}
 
-        const float dx = obj->position.x - tower_center.x;
-        const float dy = obj->position.y - tower_center.y;
-        const float dist_sq = dx * dx + dy * dy;
+// Index of the tower's current target while it is alive and still in range, else -1
+static int retained_target(const game *g, const size_t index, const vector2 tower_center) {
+    const tower_store* towers = &g->towers;
+    const enemy_store* enemies = &g->enemies;
 
-        if (dist_sq < nearest_dist_sq) {
-            nearest_dist_sq = dist_sq;
-            nearest_id = obj->id;
-        }
+    const int target = handle_table_resolve(&g->handles, towers->target_id[index], enemy);
+    if (target < 0 || !enemies->is_active[target]) {
+        return -1;
     }
 
-    return nearest_id;
+    const float dx = enemies->pos_x[target] - tower_center.x;
+    const float dy = enemies->pos_y[target] - tower_center.y;
+    const float range = towers->range[index];
+
+    return dx * dx + dy * dy < range * range ? target : -1;
 }
 
-void update_tower(game *g, game_object *twr, const float delta_time) {
-    if (g == nullptr || twr == nullptr) return;
+static int find_policy_target(game *g, const size_t index, const vector2 tower_pos) {
+    const tower_store* towers = &g->towers;
+    const tower_target_policy policy = towers->target_policy[index];
 
-    if (!twr->is_active || twr->data.tower.level == level_0) {
-        return;
+    if (policy == target_policy_nearest) {
+        return find_nearest_enemy_in_range(g, tower_pos, towers->range[index]);
     }
 
-    if (twr->data.tower.fire_cooldown > 0) {
-        twr->data.tower.fire_cooldown -= delta_time;
+    const vector2 tower_center = {tower_pos.x + 2.0f, tower_pos.y + 2.0f};
+    return target_index_select(&g->targets, &g->enemies, &g->handles, &g->enemy_grid, policy,
+                               tower_center, towers->range[index]);
+}
+
+// Returns true once the tower has fired and been scheduled for its next shot
+static bool fire_tower(game *g, const size_t index) {
+    tower_store* towers = &g->towers;
+
+    if (!towers->is_active[index] || towers->level[index] == level_0) {
+        return false;
     }
 
-    const vector2 tower_pos = twr->position;
-    const int target_id = find_nearest_enemy_in_range(g, tower_pos, twr->data.tower.range);
+    const vector2 tower_pos = {towers->pos_x[index], towers->pos_y[index]};
+    const vector2 tower_center = {tower_pos.x + 2.0f, tower_pos.y + 2.0f};
+    const enemy_store* enemies = &g->enemies;
+
+    // Stay on the current target until it dies or walks out of range, even if
+    // a closer enemy shows up; only then pay for a full search
+    int target = retained_target(g, index, tower_center);
+    if (target < 0) {
+        const int target_id = find_policy_target(g, index, tower_pos);
+
+        towers->target_id[index] = target_id;
+        target = handle_table_resolve(&g->handles, target_id, enemy);
+        if (target < 0 || !enemies->is_active[target]) {
+            return false;
+        }
+    }
+
+    const int target_id = towers->target_id[index];
+
+    if (towers->fire_mode[index] == tower_fire_analytic) {
+        const result_code res = schedule_impact(g, tower_center, towers->damage[index], target_id);
+        if (res != result_ok) {
+            fprintf(stderr, "ERROR: Failed to schedule impact: code %u\n", (unsigned)res);
+            return false;
+        }
+    }
+    else {
+        const vector2 target_pos = {enemies->pos_x[target], enemies->pos_y[target]};
+
+        const game_object proj = create_projectile(
+            tower_center,
+            target_pos,
+            towers->damage[index],
+            towers->ids[index],
+            target_id
+        );
+
+        // A full command buffer only defers the shot; the tower stays ready
+        // and fires on a later tick once the buffer has drained
+        const result_code res = queue_spawn(g, proj);
+        if (res == result_error_out_of_bounds) {
+            return false;
+        }
+        if (res != result_ok) {
+            fprintf(stderr, "ERROR: Failed to queue projectile: code %u\n", (unsigned)res);
+            return false;
+        }
+    }
 
-    if (target_id == -1) {
-        twr->data.tower.target_id = -1;
-        return;
+    if (schedule_next_shot(g, index) != result_ok) {
+        fprintf(stderr, "ERROR: Failed to schedule tower reload\n");
+        return false;
     }
 
-    twr->data.tower.target_id = target_id;
+    return true;
+}
+
+void update_towers(game *g) {
+    if (g == nullptr) return;
 
-    if (twr->data.tower.fire_cooldown <= 0) {
-        for (size_t i = 0; i < g->object_count; i++) {
-            if (g->game_objects[i].id == target_id && g->game_objects[i].is_active) {
-                const vector2 tower_center = {tower_pos.x + 2.0f, tower_pos.y + 2.0f};
-                const vector2 target_pos = g->game_objects[i].position;
+    tower_schedule* schedule = &g->tower_schedule;
 
-                const game_object proj = create_projectile(
-                    tower_center,
-                    target_pos,
-                    twr->data.tower.damage,
-                    twr->id,
-                    target_id
-                );
+    scheduled_event event;
+    while (event_heap_pop_due(&schedule->reloading, g->tick, &event)) {
+        if (push_ready_tower(schedule, event.id) != result_ok) {
+            fprintf(stderr, "ERROR: Failed to mark tower ready\n");
+        }
+    }
 
-                const result_code res = add_game_object(g, proj);
-                if (res != result_ok) {
-                    fprintf(stderr, "ERROR: Failed to add projectile: code %u\n", (unsigned)res);
-                    return;
-                }
+    size_t waiting = 0;
+    for (size_t r = 0; r < schedule->ready_count; r++) {
+        const int id = schedule->ready[r];
+        const int index = handle_table_resolve(&g->handles, id, tower);
 
-                twr->data.tower.fire_cooldown = TOWER_LEVEL_1_FIRE_COOLDOWN;
-                break;
-            }
+        if (index < 0) {
+            continue;
+        }
+        if (!fire_tower(g, (size_t)index)) {
+            schedule->ready[waiting++] = id;
         }
     }
+    schedule->ready_count = waiting;
 }
@@ -5,7 +5,10 @@
 #ifndef PROJEKT_TOWER_H
 #define PROJEKT_TOWER_H
 
+#include <stddef.h>
+
 #include "game_object.h"
+#include "event_heap.h"
 
 #define TOWER_LEVEL_0_DAMAGE 25.0f
 #define TOWER_LEVEL_0_RANGE 5.0f
@@ -18,15 +21,33 @@
 #define TOWER_LEVEL_1_RANGE 8.0f
 #define TOWER_LEVEL_1_FIRE_COOLDOWN 0.6f
 
+#define TOWER_DEFAULT_FIRE_MODE tower_fire_projectile
+#define TOWER_DEFAULT_TARGET_POLICY target_policy_nearest
+
 typedef struct game game;
 
+// Upgraded towers wait in the heap while reloading and move to the ready list
+// once their next shot is due; they stay there until they find a target.
+typedef struct {
+    event_heap reloading;
+    int *ready;
+    size_t ready_count;
+    size_t ready_capacity;
+} tower_schedule;
+
+result_code tower_schedule_init(tower_schedule *schedule, size_t capacity);
+void tower_schedule_free(tower_schedule *schedule);
+
 game_object init_tower(vector2 position);
 
 upgrade_result upgrade_clicked_tower(game *g, grid_coord coord);
+upgrade_result upgrade_tower(game *g, size_t index);
+bool cycle_clicked_tower_policy(game *g, grid_coord coord);
+const char* get_target_policy_name(tower_target_policy policy);
 
 sprite_info get_tower_sprites(tower_level level);
 
-void update_tower(game *g, game_object *twr, float delta_time);
+void update_towers(game *g);
 
 int find_nearest_enemy_in_range(const game *g, vector2 tower_pos, float range);
 
@@ -0,0 +1,175 @@
+#include "game.h"
+#include "projectile.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <time.h>
+
+// Times one projectile update against the per-tile enemy grid and compares
+// it with testing every projectile against every enemy. Each row spawns
+// `count` enemies on the left half of the map and `count` projectiles
+// anywhere on it, so roughly half of the shots miss and scan everything.
+// Object counts deliberately exceed MAX_GAME_OBJECTS, so objects are pushed
+// straight into the stores instead of going through add_game_object.
+
+#define BENCH_REPEATS 5
+#define BENCH_SEED 42u
+#define COLLISION_RADIUS_SQ 1.0f
+
+static const size_t bench_sizes[] = { 1000, 2500, 5000, 10000 };
+
+static double now_seconds(void) {
+    struct timespec ts;
+    timespec_get(&ts, TIME_UTC);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+static float random_coord(game *g, const int limit) {
+    return (float)game_random_value(g, 0, limit * 100 - 1) / 100.0f;
+}
+
+static bool push_object(game *g, game_object obj) {
+    const size_t index = obj.type == enemy ? enemy_store_next_slot(&g->enemies)
+                                           : projectile_store_next_slot(&g->projectiles);
+
+    obj.id = handle_table_acquire(&g->handles, obj.type, index);
+    if (obj.id == INVALID_HANDLE) {
+        return false;
+    }
+
+    const result_code res = obj.type == enemy ? enemy_store_push(&g->enemies, &obj)
+                                              : projectile_store_push(&g->projectiles, &obj);
+    return res == result_ok;
+}
+
+static bool populate(game *g, const size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        const bool ok = push_object(g, (game_object) {
+            .type = enemy,
+            .position = { random_coord(g, MAP_WIDTH / 2), random_coord(g, MAP_HEIGHT) },
+            .is_active = true,
+            .data.enemy = {
+                .health = 1e9f,
+                .max_health = 1e9f,
+                .speed = 0.0f,
+                .type = enemy_type_mushroom,
+                .anim_state = enemy_anim_run
+            }
+        });
+        if (!ok) return false;
+    }
+
+    for (size_t i = 0; i < count; i++) {
+        const vector2 start = { random_coord(g, MAP_WIDTH), random_coord(g, MAP_HEIGHT) };
+        const vector2 aim = { random_coord(g, MAP_WIDTH), random_coord(g, MAP_HEIGHT) };
+        if (!push_object(g, create_projectile(start, aim, 1.0f, INVALID_HANDLE, INVALID_HANDLE))) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+// Same closest-point test as the simulation, from prev to pos of each projectile
+static size_t brute_force_hits(const game *g) {
+    const enemy_store* enemies = &g->enemies;
+    const projectile_store* projectiles = &g->projectiles;
+    size_t hits = 0;
+
+    for (size_t p = 0; p < projectiles->count; p++) {
+        const float step_x = projectiles->pos_x[p] - projectiles->prev_x[p];
+        const float step_y = projectiles->pos_y[p] - projectiles->prev_y[p];
+        const float step_sq = step_x * step_x + step_y * step_y;
+
+        for (size_t e = 0; e < enemies->count; e++) {
+            const float to_x = enemies->pos_x[e] - projectiles->prev_x[p];
+            const float to_y = enemies->pos_y[e] - projectiles->prev_y[p];
+
+            float t = 0.0f;
+            if (step_sq > 0.000001f) {
+                t = fminf(fmaxf((to_x * step_x + to_y * step_y) / step_sq, 0.0f), 1.0f);
+            }
+
+            const float dx = to_x - step_x * t;
+            const float dy = to_y - step_y * t;
+            if (dx * dx + dy * dy < COLLISION_RADIUS_SQ) {
+                hits++;
+                break;
+            }
+        }
+    }
+
+    return hits;
+}
+
+static size_t count_inactive(const projectile_store *projectiles) {
+    size_t inactive = 0;
+    for (size_t i = 0; i < projectiles->count; i++) {
+        if (!projectiles->is_active[i]) inactive++;
+    }
+    return inactive;
+}
+
+static bool run_size(const size_t count) {
+    double grid_time = 0.0;
+    double update_time = 0.0;
+    double brute_time = 0.0;
+    size_t grid_hits = 0;
+    size_t brute_hits = 0;
+
+    for (int repeat = 0; repeat < BENCH_REPEATS; repeat++) {
+        game g;
+        if (init_game_state(&g, BENCH_SEED + (unsigned int)repeat) != result_ok) {
+            return false;
+        }
+        if (!populate(&g, count)) {
+            fprintf(stderr, "ERROR: Failed to populate %zu objects\n", count);
+            free_game_state(&g);
+            return false;
+        }
+
+        projectile_store_save_positions(&g.projectiles);
+
+        const double grid_start = now_seconds();
+        if (spatial_grid_build(&g.enemy_grid, &g.enemies) != result_ok) {
+            fprintf(stderr, "ERROR: Failed to build enemy grid\n");
+            free_game_state(&g);
+            return false;
+        }
+        const double built = now_seconds();
+        update_projectiles(&g, SIM_TICK_DURATION);
+        const double updated = now_seconds();
+
+        grid_time += built - grid_start;
+        update_time += updated - built;
+        grid_hits = count_inactive(&g.projectiles);
+
+        // Projectiles have moved; the brute force scan checks the same positions
+        const double brute_start = now_seconds();
+        brute_hits = brute_force_hits(&g);
+        brute_time += now_seconds() - brute_start;
+
+        free_game_state(&g);
+    }
+
+    printf("%8zu %12.3f %12.3f %12.3f %8zu %8zu\n",
+           count,
+           grid_time * 1000.0 / BENCH_REPEATS,
+           update_time * 1000.0 / BENCH_REPEATS,
+           brute_time * 1000.0 / BENCH_REPEATS,
+           grid_hits, brute_hits);
+    return true;
+}
+
+int main(void) {
+    printf("%8s %12s %12s %12s %8s %8s\n",
+           "count", "grid ms", "update ms", "brute ms", "hits", "brute");
+
+    for (size_t i = 0; i < sizeof(bench_sizes) / sizeof(bench_sizes[0]); i++) {
+        if (!run_size(bench_sizes[i])) {
+            return 1;
+        }
+    }
+
+    return 0;
+}
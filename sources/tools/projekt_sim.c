@@ -0,0 +1,185 @@
+#include "game.h"
+#include "tower.h"
+#include "simd_kernels.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <time.h>
+
+#define DEFAULT_WAVES 10
+#define DEFAULT_SEED 1u
+
+typedef enum {
+    build_action_build,
+    build_action_upgrade
+} build_action;
+
+typedef struct {
+    int wave;
+    build_action action;
+    int spot;
+} build_step;
+
+// Applied in order; a step waits until its wave has started and it is affordable
+static const build_step build_order[] = {
+    {.wave = 0, .action = build_action_upgrade, .spot = 0},
+    {.wave = 0, .action = build_action_build, .spot = 3},
+    {.wave = 1, .action = build_action_upgrade, .spot = 3},
+    {.wave = 2, .action = build_action_build, .spot = 1},
+    {.wave = 3, .action = build_action_upgrade, .spot = 1},
+    {.wave = 4, .action = build_action_build, .spot = 2},
+    {.wave = 5, .action = build_action_upgrade, .spot = 2},
+    {.wave = 6, .action = build_action_upgrade, .spot = 0},
+    {.wave = 7, .action = build_action_upgrade, .spot = 3},
+    {.wave = 8, .action = build_action_upgrade, .spot = 1},
+    {.wave = 9, .action = build_action_upgrade, .spot = 2}
+};
+
+static constexpr size_t build_order_count = sizeof(build_order) / sizeof(build_order[0]);
+
+static bool apply_build_step(game *g, const build_step *step) {
+    if (step->action == build_action_build) {
+        return g->tower_spots[step->spot].occupied || try_build_tower(g, step->spot);
+    }
+
+    const grid_coord coord = {
+        .x = (int)g->tower_spots[step->spot].position.x,
+        .y = (int)g->tower_spots[step->spot].position.y
+    };
+
+    const upgrade_result result = upgrade_clicked_tower(g, coord);
+    return result != upgrade_insufficient_funds;
+}
+
+static void apply_tower_settings(game *g, const tower_fire_mode mode, const tower_target_policy policy) {
+    for (size_t i = 0; i < g->towers.count; i++) {
+        g->towers.fire_mode[i] = mode;
+        g->towers.target_policy[i] = policy;
+    }
+}
+
+static bool parse_policy(const char *text, tower_target_policy *out) {
+    for (int policy = 0; policy < target_policy_count; policy++) {
+        const char *name = get_target_policy_name((tower_target_policy)policy);
+        if (strcasecmp(text, name) == 0) {
+            *out = (tower_target_policy)policy;
+            return true;
+        }
+    }
+    return false;
+}
+
+static double now_seconds(void) {
+    struct timespec ts;
+    timespec_get(&ts, TIME_UTC);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+static bool parse_long(const char *text, long min, long max, long *out) {
+    char *end = nullptr;
+    const long value = strtol(text, &end, 10);
+    if (end == text || *end != '\0' || value < min || value > max) {
+        return false;
+    }
+    *out = value;
+    return true;
+}
+
+static void print_usage(const char *program) {
+    fprintf(stderr, "Usage: %s [--waves N] [--seed S] [--fire-mode analytic|projectile]\n"
+                    "       [--target-policy nearest|first|last|strongest|weakest] [--eager-enemies]\n", program);
+}
+
+int main(const int argc, char **argv) {
+    long waves = DEFAULT_WAVES;
+    long seed = DEFAULT_SEED;
+    tower_fire_mode fire_mode = TOWER_DEFAULT_FIRE_MODE;
+    tower_target_policy policy = TOWER_DEFAULT_TARGET_POLICY;
+    bool lazy_enemies = LAZY_ENEMY_POSITIONS;
+
+    for (int i = 1; i < argc; i++) {
+        const bool has_value = i + 1 < argc;
+        if (strcmp(argv[i], "--waves") == 0 && has_value && parse_long(argv[i + 1], 1, 10000, &waves)) {
+            i++;
+        }
+        else if (strcmp(argv[i], "--seed") == 0 && has_value && parse_long(argv[i + 1], 0, 0xFFFFFFFFL, &seed)) {
+            i++;
+        }
+        else if (strcmp(argv[i], "--fire-mode") == 0 && has_value && strcmp(argv[i + 1], "analytic") == 0) {
+            fire_mode = tower_fire_analytic;
+            i++;
+        }
+        else if (strcmp(argv[i], "--fire-mode") == 0 && has_value && strcmp(argv[i + 1], "projectile") == 0) {
+            fire_mode = tower_fire_projectile;
+            i++;
+        }
+        else if (strcmp(argv[i], "--target-policy") == 0 && has_value && parse_policy(argv[i + 1], &policy)) {
+            i++;
+        }
+        else if (strcmp(argv[i], "--eager-enemies") == 0) {
+            lazy_enemies = false;
+        }
+        else {
+            print_usage(argv[0]);
+            return 1;
+        }
+    }
+
+    game g;
+    if (init_game_state(&g, (unsigned int)seed) != result_ok) {
+        return 1;
+    }
+
+    g.lazy_enemies = lazy_enemies;
+    apply_tower_settings(&g, fire_mode, policy);
+    start_next_wave(&g);
+    g.state = game_state_playing;
+
+    size_t next_step = 0;
+    long ticks = 0;
+    const double start_time = now_seconds();
+
+    while (g.state != game_state_game_over) {
+        while (next_step < build_order_count &&
+               build_order[next_step].wave <= g.current_wave &&
+               apply_build_step(&g, &build_order[next_step])) {
+            apply_tower_settings(&g, fire_mode, policy);
+            next_step++;
+        }
+
+        if (g.state == game_state_wave_break) {
+            printf("wave %3d  ticks %9ld  lives %3d  money %6d  defeated %6d\n",
+                   g.current_wave + 1, ticks, g.player_lives, g.player_money, g.enemies_defeated);
+
+            if (g.current_wave + 1 >= waves) {
+                break;
+            }
+
+            // Skip the break the way a player pressing space would
+            start_next_wave(&g);
+            g.state = game_state_playing;
+        }
+
+        simulate_tick(&g);
+        ticks++;
+    }
+
+    const double elapsed = now_seconds() - start_time;
+
+    if (g.state == game_state_game_over) {
+        printf("defeated during wave %d\n", g.current_wave + 1);
+    }
+
+    printf("kernels %s  seed %ld  ticks %ld  sim time %.1fs  wall time %.3fs  %.0f ticks/s\n",
+           simd_kernel_name(), seed, ticks, (double)ticks / SIM_TICK_RATE, elapsed,
+           elapsed > 0.0 ? (double)ticks / elapsed : 0.0);
+
+    const pool_stats stats = get_object_pool_stats(&g);
+    printf("store resizes %zu  compactions %zu  bytes moved %zu\n",
+           stats.resizes, stats.compactions, stats.bytes_moved);
+
+    free_game_state(&g);
+    return 0;
+}
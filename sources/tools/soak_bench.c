@@ -0,0 +1,214 @@
+#include "game.h"
+#include "tower.h"
+#include "enemy.h"
+#include "vm_region.h"
+
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define DEFAULT_WAVES 10
+#define DEFAULT_SEED 1u
+#define SOAK_LIVES (INT_MAX / 2)
+#define SOAK_MONEY (INT_MAX / 2)
+
+// Extra towers stand along the paths and fire faster than a real tower so
+// projectiles pile up as well as enemies. Every path and spot tower firing on
+// the same tick still fits in the command buffer next to a full spawn batch.
+#define DEFAULT_PATH_TOWERS 128
+#define MAX_PATH_TOWERS (COMMAND_BUFFER_CAPACITY - HORDE_MAX_SPAWN_BATCH - TOWER_SPOT_COUNT)
+#define SOAK_FIRE_COOLDOWN 0.1f
+
+typedef struct {
+    size_t peak_enemies;
+    size_t peak_projectiles;
+    double tick_seconds;
+    double max_tick_seconds;
+    size_t peak_resident_bytes;
+    bool resident_known;
+    long ticks;
+} wave_sample;
+
+static double now_seconds(void) {
+    struct timespec ts;
+    timespec_get(&ts, TIME_UTC);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+static bool parse_long(const char *text, long min, long max, long *out) {
+    char *end = nullptr;
+    const long value = strtol(text, &end, 10);
+    if (end == text || *end != '\0' || value < min || value > max) {
+        return false;
+    }
+    *out = value;
+    return true;
+}
+
+static void print_usage(const char *program) {
+    fprintf(stderr, "Usage: %s [--waves N] [--seed S] [--fire-mode analytic|projectile] [--towers N]\n", program);
+}
+
+// Every spot built and upgraded, so the horde is what limits the run
+static void build_all_towers(game *g, const tower_fire_mode mode) {
+    for (int spot = 0; spot < TOWER_SPOT_COUNT; spot++) {
+        if (!g->tower_spots[spot].occupied) {
+            try_build_tower(g, spot);
+        }
+
+        const grid_coord coord = {
+            .x = (int)g->tower_spots[spot].position.x,
+            .y = (int)g->tower_spots[spot].position.y
+        };
+        upgrade_clicked_tower(g, coord);
+    }
+
+    for (size_t i = 0; i < g->towers.count; i++) {
+        g->towers.fire_mode[i] = mode;
+    }
+}
+
+// Spreads upgraded rapid-fire towers evenly over both paths
+static bool build_path_towers(game *g, const long count, const tower_fire_mode mode) {
+    const long per_path = (count + PATH_COUNT - 1) / PATH_COUNT;
+
+    for (long t = 0; t < count; t++) {
+        const int path_id = (int)(t % PATH_COUNT);
+        const float distance = get_path_length(path_id) * ((float)(t / PATH_COUNT) + 0.5f) / (float)per_path;
+        const vector2 on_path = get_path_position(path_id, distance);
+
+        const size_t index = tower_store_next_slot(&g->towers);
+        const result_code res = add_game_object(g, init_tower((vector2){on_path.x - 2.0f, on_path.y - 2.0f}));
+        if (res != result_ok) {
+            fprintf(stderr, "ERROR: Failed to add path tower: code %u\n", (unsigned)res);
+            return false;
+        }
+        if (upgrade_tower(g, index) != upgrade_success) {
+            fprintf(stderr, "ERROR: Failed to upgrade path tower\n");
+            return false;
+        }
+        g->towers.fire_mode[index] = mode;
+        g->towers.fire_cooldown[index] = SOAK_FIRE_COOLDOWN;
+    }
+    return true;
+}
+
+static void sample_tick(wave_sample *sample, wave_sample *overall, const game *g, const double seconds) {
+    const size_t enemies = g->enemies.count - g->enemies.free_count;
+    const size_t projectiles = g->projectiles.count - g->projectiles.free_count;
+
+    if (enemies > sample->peak_enemies) sample->peak_enemies = enemies;
+    if (projectiles > sample->peak_projectiles) sample->peak_projectiles = projectiles;
+    if (enemies > overall->peak_enemies) overall->peak_enemies = enemies;
+    if (projectiles > overall->peak_projectiles) overall->peak_projectiles = projectiles;
+    if (seconds > sample->max_tick_seconds) sample->max_tick_seconds = seconds;
+    sample->tick_seconds += seconds;
+
+    // Reading /proc costs more than a tick, so resident memory is sampled once a second
+    if (sample->ticks % SIM_TICK_RATE == 0) {
+        const size_t resident = vm_resident_bytes();
+        if (resident != VM_RESIDENT_UNKNOWN) {
+            if (resident > sample->peak_resident_bytes) sample->peak_resident_bytes = resident;
+            sample->resident_known = true;
+        }
+    }
+    sample->ticks++;
+}
+
+int main(const int argc, char **argv) {
+    long waves = DEFAULT_WAVES;
+    long seed = DEFAULT_SEED;
+    tower_fire_mode fire_mode = tower_fire_projectile;
+    long path_towers = DEFAULT_PATH_TOWERS;
+
+    for (int i = 1; i < argc; i++) {
+        const bool has_value = i + 1 < argc;
+        if (strcmp(argv[i], "--waves") == 0 && has_value && parse_long(argv[i + 1], 1, 1000, &waves)) {
+            i++;
+        }
+        else if (strcmp(argv[i], "--seed") == 0 && has_value && parse_long(argv[i + 1], 0, 0xFFFFFFFFL, &seed)) {
+            i++;
+        }
+        else if (strcmp(argv[i], "--fire-mode") == 0 && has_value && strcmp(argv[i + 1], "analytic") == 0) {
+            fire_mode = tower_fire_analytic;
+            i++;
+        }
+        else if (strcmp(argv[i], "--fire-mode") == 0 && has_value && strcmp(argv[i + 1], "projectile") == 0) {
+            fire_mode = tower_fire_projectile;
+            i++;
+        }
+        else if (strcmp(argv[i], "--towers") == 0 && has_value && parse_long(argv[i + 1], 0, MAX_PATH_TOWERS, &path_towers)) {
+            i++;
+        }
+        else {
+            print_usage(argv[0]);
+            return 1;
+        }
+    }
+
+    game g;
+    if (init_game_state(&g, (unsigned int)seed) != result_ok) {
+        return 1;
+    }
+
+    enable_endless_mode(&g);
+    g.player_lives = SOAK_LIVES;
+    g.player_money = SOAK_MONEY;
+    build_all_towers(&g, fire_mode);
+    if (!build_path_towers(&g, path_towers, fire_mode)) {
+        free_game_state(&g);
+        return 1;
+    }
+    start_next_wave(&g);
+    g.state = game_state_playing;
+
+    printf("wave  spawned   peak enemies  peak projectiles  mean tick ms  max tick ms  peak rss MB  dropped\n");
+
+    wave_sample sample = {0};
+    wave_sample overall = {0};
+    const double start_time = now_seconds();
+    long total_ticks = 0;
+
+    while (g.state != game_state_game_over) {
+        if (g.state == game_state_wave_break) {
+            char resident[32] = "unknown";
+            if (sample.resident_known) {
+                snprintf(resident, sizeof(resident), "%.1f", (double)sample.peak_resident_bytes / (1024.0 * 1024.0));
+            }
+            printf("%4d  %7d   %12zu  %16zu  %12.3f  %11.3f  %11s  %7zu\n",
+                   g.current_wave + 1, g.enemies_spawned_in_wave, sample.peak_enemies, sample.peak_projectiles,
+                   sample.ticks > 0 ? sample.tick_seconds * 1000.0 / (double)sample.ticks : 0.0,
+                   sample.max_tick_seconds * 1000.0, resident, g.spawns_rejected);
+            fflush(stdout);
+
+            if (g.current_wave + 1 >= waves) {
+                break;
+            }
+
+            sample = (wave_sample){0};
+            start_next_wave(&g);
+            g.state = game_state_playing;
+        }
+
+        const double tick_start = now_seconds();
+        simulate_tick(&g);
+        sample_tick(&sample, &overall, &g, now_seconds() - tick_start);
+        total_ticks++;
+    }
+
+    const double elapsed = now_seconds() - start_time;
+    printf("seed %ld  ticks %ld  sim time %.1fs  wall time %.3fs  defeated %d  lives lost %d\n",
+           seed, total_ticks, (double)total_ticks / SIM_TICK_RATE, elapsed,
+           g.enemies_defeated, SOAK_LIVES - g.player_lives);
+    printf("towers %zu  peak enemies %zu  peak projectiles %zu\n",
+           g.towers.count - g.towers.free_count, overall.peak_enemies, overall.peak_projectiles);
+
+    const pool_stats stats = get_object_pool_stats(&g);
+    printf("store resizes %zu  compactions %zu  bytes moved %zu\n",
+           stats.resizes, stats.compactions, stats.bytes_moved);
+
+    free_game_state(&g);
+    return 0;
+}
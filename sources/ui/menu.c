@@ -19,7 +19,7 @@ static void update_button(menu_button* btn) {
 }
 
 // Helper: Render button with hover effect
-static void render_button(const menu_button* btn) {
+static void render_button(menu_button* btn) {
     if (!btn || !btn->text) return;
 
     const color bg_color = btn->hovered ?
@@ -48,11 +48,24 @@ static void render_button(const menu_button* btn) {
     );
 
     // Draw text centered
-    const int text_width = measure_text(btn->text, 20);
-    const int text_x = (int)btn->position.x + ((int)btn->size.x - text_width) / 2;
+    set_label_text(&btn->label, btn->text, 20);
+    const int text_x = (int)btn->position.x + ((int)btn->size.x - btn->label.width) / 2;
     const int text_y = (int)btn->position.y + ((int)btn->size.y - 20) / 2;
 
-    draw_text(btn->text, text_x, text_y, 20, white);
+    draw_label(&btn->label, text_x, text_y, white);
+}
+
+// Helper: Draw a screen's text through the menu's labels, taken in draw order.
+// A label is rebuilt only when the screen or its text changes.
+static void draw_menu_label(menu_system* menu, const char* text, const int x, const int y, const int font_size, const color c) {
+    if (menu->next_label == MENU_LABEL_CAPACITY) {
+        draw_text(text, x, y, font_size, c);
+        return;
+    }
+
+    text_label* label = &menu->labels[menu->next_label++];
+    set_label_text(label, text, font_size);
+    draw_label(label, x, y, c);
 }
 
 // Initialize menu system
@@ -508,19 +521,19 @@ void update_menu(menu_system* menu) {
 }
 
 // Render main menu
-static void render_main_menu(const menu_system* menu) {
-    draw_text("TOWER DEFENSE", 250, 100, 40, white);
+static void render_main_menu(menu_system* menu) {
+    draw_menu_label(menu, "TOWER DEFENSE", 250, 100, 40, white);
 
     for (int i = 0; i < 3; i++) {
         render_button(&menu->main_buttons[i]);
     }
 
-    draw_text("Use mouse to select", 300, 450, 16, lightgray);
+    draw_menu_label(menu, "Use mouse to select", 300, 450, 16, lightgray);
 }
 
 // Render multiplayer selection menu
-static void render_multiplayer_menu(const menu_system* menu) {
-    draw_text("MULTIPLAYER", 280, 100, 40, white);
+static void render_multiplayer_menu(menu_system* menu) {
+    draw_menu_label(menu, "MULTIPLAYER", 280, 100, 40, white);
 
     for (int i = 0; i < 3; i++) {
         render_button(&menu->multi_buttons[i]);
@@ -528,11 +541,11 @@ static void render_multiplayer_menu(const menu_system* menu) {
 }
 
 // Render IP entry screen
-static void render_join_ip_menu(const menu_system* menu) {
-    draw_text("JOIN GAME", 300, 100, 40, white);
+static void render_join_ip_menu(menu_system* menu) {
+    draw_menu_label(menu, "JOIN GAME", 300, 100, 40, white);
 
     // Draw IP input label
-    draw_text("Enter Host IP Address:", 250, 200, 20, white);
+    draw_menu_label(menu, "Enter Host IP Address:", 250, 200, 20, white);
 
     // Draw IP input box
     const color input_bg = menu->ip_input_active ?
@@ -551,7 +564,7 @@ static void render_join_ip_menu(const menu_system* menu) {
         draw_rectangle(cursor_x, 240, 2, 20, white);
     }
 
-    draw_text("Click to edit. Numbers and dots only.", 250, 275, 14, lightgray);
+    draw_menu_label(menu, "Click to edit. Numbers and dots only.", 250, 275, 14, lightgray);
 
     // Draw port info
     char port_text[64];
@@ -564,16 +577,16 @@ static void render_join_ip_menu(const menu_system* menu) {
     }
 
     // Draw help text
-    draw_text("For local testing use: 127.0.0.1", 200, 420, 16, lightgray);
-    draw_text("For LAN use host's local IP: 192.168.x.x", 180, 445, 16, lightgray);
+    draw_menu_label(menu, "For local testing use: 127.0.0.1", 200, 420, 16, lightgray);
+    draw_menu_label(menu, "For LAN use host's local IP: 192.168.x.x", 180, 445, 16, lightgray);
 }
 
 // Render host setup screen
-static void render_host_setup(const menu_system* menu) {
-    draw_text("HOST GAME SETUP", 250, 100, 36, white);
+static void render_host_setup(menu_system* menu) {
+    draw_menu_label(menu, "HOST GAME SETUP", 250, 100, 36, white);
 
     // Host name input
-    draw_text("Session Name:", 250, 180, 20, white);
+    draw_menu_label(menu, "Session Name:", 250, 180, 20, white);
     const color name_input_bg = menu->host_name_input_active ?
         (color){80, 80, 80, 255} : (color){60, 60, 60, 255};
     const color name_border = menu->host_name_input_active ? green : white;
@@ -588,7 +601,7 @@ static void render_host_setup(const menu_system* menu) {
     }
 
     // Port input
-    draw_text("Port:", 250, 270, 20, white);
+    draw_menu_label(menu, "Port:", 250, 270, 20, white);
     const color port_input_bg = menu->port_input_active ?
         (color){80, 80, 80, 255} : (color){60, 60, 60, 255};
     const color port_border = menu->port_input_active ? green : white;
@@ -602,7 +615,7 @@ static void render_host_setup(const menu_system* menu) {
         draw_rectangle(cursor_x, 310, 2, 20, white);
     }
 
-    draw_text("Click fields to edit (letters, numbers, space, - and _ allowed)", 160, 345, 14, lightgray);
+    draw_menu_label(menu, "Click fields to edit (letters, numbers, space, - and _ allowed)", 160, 345, 14, lightgray);
 
     // Buttons
     for (int i = 0; i < 2; i++) {
@@ -611,15 +624,15 @@ static void render_host_setup(const menu_system* menu) {
 }
 
 // Render host waiting screen
-static void render_host_waiting(const menu_system* menu) {
-    draw_text("HOSTING GAME", 280, 100, 40, white);
+static void render_host_waiting(menu_system* menu) {
+    draw_menu_label(menu, "HOSTING GAME", 280, 100, 40, white);
 
     if (menu->connection_failed) {
-        draw_text("Failed to start server!", 250, 200, 24, red);
+        draw_menu_label(menu, "Failed to start server!", 250, 200, 24, red);
         draw_text(menu->error_message, 200, 240, 18, red);
-        draw_text("Press ESC or click Cancel to go back", 200, 280, 18, lightgray);
+        draw_menu_label(menu, "Press ESC or click Cancel to go back", 200, 280, 18, lightgray);
     } else {
-        draw_text("Waiting for player to connect...", 200, 200, 24, white);
+        draw_menu_label(menu, "Waiting for player to connect...", 200, 200, 24, white);
 
         // Animated dots
         const unsigned int dot_count = SDL_GetTicks() / 500 % 4;
@@ -630,9 +643,9 @@ static void render_host_waiting(const menu_system* menu) {
         draw_text(dots, 560, 200, 24, white);
 
         // Instructions
-        draw_text("Tell the other player to connect to:", 200, 260, 18, lightgray);
-        draw_text("127.0.0.1 (if testing on same PC)", 220, 290, 20, gold);
-        draw_text("OR your local IP (use 'ip addr' command)", 180, 320, 20, gold);
+        draw_menu_label(menu, "Tell the other player to connect to:", 200, 260, 18, lightgray);
+        draw_menu_label(menu, "127.0.0.1 (if testing on same PC)", 220, 290, 20, gold);
+        draw_menu_label(menu, "OR your local IP (use 'ip addr' command)", 180, 320, 20, gold);
 
         char port_text[64];
         snprintf(port_text, sizeof(port_text), "Port: %d", menu->port_number);
@@ -644,15 +657,15 @@ static void render_host_waiting(const menu_system* menu) {
 }
 
 // Render game browser
-static void render_join_browser(const menu_system* menu) {
-    draw_text("AVAILABLE GAMES", 240, 80, 30, white);
+static void render_join_browser(menu_system* menu) {
+    draw_menu_label(menu, "AVAILABLE GAMES", 240, 80, 30, white);
 
     if (menu->available_game_count == 0) {
-        draw_text("No games found on local network", 220, 250, 18, lightgray);
-        draw_text("Make sure the host is running", 230, 280, 16, lightgray);
+        draw_menu_label(menu, "No games found on local network", 220, 250, 18, lightgray);
+        draw_menu_label(menu, "Make sure the host is running", 230, 280, 16, lightgray);
     } else {
         // Render discovered games
-        draw_text("Select a game to join:", 250, 130, 18, white);
+        draw_menu_label(menu, "Select a game to join:", 250, 130, 18, white);
 
         for (int i = 0; i < menu->available_game_count && i < 8; i++) {
             const int y = 170 + i * 35;
@@ -679,14 +692,14 @@ static void render_join_browser(const menu_system* menu) {
 
     // Bottom buttons
     render_button(&menu->refresh_button);
-    draw_text("Or:", 370, 450, 16, lightgray);
+    draw_menu_label(menu, "Or:", 370, 450, 16, lightgray);
     render_button(&menu->manual_ip_button);
     render_button(&menu->back_button);
 }
 
 // Render connecting screen
-static void render_connecting(const menu_system* menu) {
-    draw_text("CONNECTING", 300, 250, 30, white);
+static void render_connecting(menu_system* menu) {
+    draw_menu_label(menu, "CONNECTING", 300, 250, 30, white);
 
     char msg[128];
     snprintf(msg, sizeof(msg), "Connecting to %s:%d...",
@@ -694,16 +707,18 @@ static void render_connecting(const menu_system* menu) {
     draw_text(msg, 200, 300, 20, white);
 
     if (menu->connection_failed) {
-        draw_text("Connection Failed!", 270, 350, 24, red);
+        draw_menu_label(menu, "Connection Failed!", 270, 350, 24, red);
         draw_text(menu->error_message, 200, 380, 16, red);
-        draw_text("Press ESC to go back", 260, 420, 18, lightgray);
+        draw_menu_label(menu, "Press ESC to go back", 260, 420, 18, lightgray);
     }
 }
 
 // Main render function - routes to correct state
-void render_menu(const menu_system* menu) {
+void render_menu(menu_system* menu) {
     if (!menu) return;
 
+    menu->next_label = 0;
+
     clear_background((color){20, 20, 30, 255});
 
     switch (menu->current_state) {
@@ -747,6 +762,22 @@ void render_menu(const menu_system* menu) {
 void cleanup_menu(menu_system* menu) {
     if (!menu) return;
 
+    for (int i = 0; i < MENU_LABEL_CAPACITY; i++) {
+        unload_label(&menu->labels[i]);
+    }
+
+    menu_button* const buttons[] = {
+        &menu->main_buttons[0], &menu->main_buttons[1], &menu->main_buttons[2],
+        &menu->multi_buttons[0], &menu->multi_buttons[1], &menu->multi_buttons[2],
+        &menu->ip_buttons[0], &menu->ip_buttons[1],
+        &menu->host_setup_buttons[0], &menu->host_setup_buttons[1],
+        &menu->host_buttons[0],
+        &menu->manual_ip_button, &menu->refresh_button, &menu->back_button,
+    };
+    for (size_t i = 0; i < sizeof(buttons) / sizeof(buttons[0]); i++) {
+        unload_label(&buttons[i]->label);
+    }
+
     // Clean up discovery
     if (menu->discovery) {
         discovery_close(menu->discovery);
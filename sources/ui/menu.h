@@ -23,10 +23,14 @@ typedef struct {
     vector2 position;
     vector2 size;
     const char* text;
+    text_label label;           // Rendered text, rebuilt when text changes
     bool hovered;
     bool clicked;
 } menu_button;
 
+// Labels available to the screen being drawn
+#define MENU_LABEL_CAPACITY 16
+
 // Discovered game info (for Phase 2.5 - game discovery)
 #define MAX_DISCOVERED_GAMES 16
 
@@ -84,12 +88,16 @@ typedef struct {
     int host_name_cursor_pos;
     bool host_name_input_active;
 
+    // Static screen text, reused between frames
+    text_label labels[MENU_LABEL_CAPACITY];
+    int next_label;
+
 } menu_system;
 
 // Main menu API
 menu_system init_menu_system(void);
 void update_menu(menu_system* menu);
-void render_menu(const menu_system* menu);
+void render_menu(menu_system* menu);
 void cleanup_menu(menu_system* menu);
 
 // State query functions - use these in main.c to check what to do
@@ -94,19 +94,21 @@ void update_multiplayer_ui(multiplayer_ui* ui) {
 
 // Render split-screen UI elements (divider and labels)
 // Note: Actual game rendering is done in main.c using SDL viewports
-void render_split_screen(const multiplayer_ui* ui, [[maybe_unused]] const game* local_game, [[maybe_unused]] const game* remote_game) {
+void render_split_screen(multiplayer_ui* ui, [[maybe_unused]] const game* local_game, [[maybe_unused]] const game* remote_game) {
     if (!ui) return;
 
     // Draw dividing line (vertical line using thin rectangle)
     draw_rectangle(ui->split_x - 1, 0, 2, ui->game_height, white);
 
     // Draw labels
-    draw_text("YOUR GAME", 20, 10, 20, green);
-    draw_text("OPPONENT", ui->split_x + 20, 10, 20, red);
+    set_label_text(&ui->local_title, "YOUR GAME", 20);
+    set_label_text(&ui->remote_title, "OPPONENT", 20);
+    draw_label(&ui->local_title, 20, 10, green);
+    draw_label(&ui->remote_title, ui->split_x + 20, 10, red);
 }
 
 // Render a single send button
-static void render_send_button(const send_enemy_button* button, const bool can_afford) {
+static void render_send_button(send_enemy_button* button, const bool can_afford) {
     // Choose color based on state
     color button_color;
     if (!can_afford) {
@@ -140,11 +142,12 @@ static void render_send_button(const send_enemy_button* button, const bool can_a
     const color text_color = can_afford ? white : (color){120, 120, 120, 255};
     const int text_x = (int)button->position.x + 10;
     const int text_y = (int)button->position.y + 12;
-    draw_text(button->label, text_x, text_y, 16, text_color);
+    set_label_text(&button->label_text, button->label, 16);
+    draw_label(&button->label_text, text_x, text_y, text_color);
 }
 
 // Render enemy sending UI
-void render_enemy_send_ui(const multiplayer_ui* ui, const game* local_game) {
+void render_enemy_send_ui(multiplayer_ui* ui, const game* local_game) {
     if (!ui || !local_game) return;
 
     // Draw background panel
@@ -152,7 +155,8 @@ void render_enemy_send_ui(const multiplayer_ui* ui, const game* local_game) {
     draw_rectangle(0, ui->game_height - 70, ui->game_width, 70, panel_color);
 
     // Draw label
-    draw_text("SEND ENEMIES TO OPPONENT:", 20, ui->game_height - 80, 16, gold);
+    set_label_text(&ui->send_title, "SEND ENEMIES TO OPPONENT:", 16);
+    draw_label(&ui->send_title, 20, ui->game_height - 80, gold);
 
     // Draw buttons
     for (int i = 0; i < 3; i++) {
@@ -176,11 +180,24 @@ int check_send_button_clicked(const multiplayer_ui* ui, int* out_cost) {
 }
 
 // Render connection status
-void render_connection_status(const multiplayer_ui* ui) {
+void render_connection_status(multiplayer_ui* ui) {
     if (!ui) return;
 
     const char* status_text = ui->is_connected ? "CONNECTED" : "DISCONNECTED";
     const color status_color = ui->is_connected ? green : red;
 
-    draw_text(status_text, ui->split_x - 80, 10, 16, status_color);
+    set_label_text(&ui->status, status_text, 16);
+    draw_label(&ui->status, ui->split_x - 80, 10, status_color);
+}
+
+void unload_multiplayer_ui(multiplayer_ui* ui) {
+    if (!ui) return;
+
+    for (int i = 0; i < 3; i++) {
+        unload_label(&ui->send_buttons[i].label_text);
+    }
+    unload_label(&ui->local_title);
+    unload_label(&ui->remote_title);
+    unload_label(&ui->send_title);
+    unload_label(&ui->status);
 }
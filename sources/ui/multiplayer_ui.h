@@ -14,6 +14,7 @@ typedef struct {
     vector2 position;
     vector2 size;
     const char* label;
+    text_label label_text;  // Rendered label, reused between frames
     int enemy_count;
     int cost;
     bool hovered;
@@ -29,6 +30,12 @@ typedef struct {
     bool is_connected;
     bool is_host;
 
+    // Retained header, panel and status text
+    text_label local_title;
+    text_label remote_title;
+    text_label send_title;
+    text_label status;
+
     // UI positioning
     int split_x;  // X position where split happens (800 for 1600px window)
     int game_width;  // Width of each game view (800)
@@ -45,15 +52,18 @@ void update_multiplayer_ui(multiplayer_ui* ui);
 void update_multiplayer_ui_dimensions(multiplayer_ui* ui, int window_width, int window_height);
 
 // Render split-screen view
-void render_split_screen(const multiplayer_ui* ui, const game* local_game, const game* remote_game);
+void render_split_screen(multiplayer_ui* ui, const game* local_game, const game* remote_game);
 
 // Render enemy sending UI
-void render_enemy_send_ui(const multiplayer_ui* ui, const game* local_game);
+void render_enemy_send_ui(multiplayer_ui* ui, const game* local_game);
 
 // Check if any send button was clicked and return enemy count (0 if none)
 int check_send_button_clicked(const multiplayer_ui* ui, int* out_cost);
 
 // Render connection status
-void render_connection_status(const multiplayer_ui* ui);
+void render_connection_status(multiplayer_ui* ui);
+
+// Release the UI's retained text
+void unload_multiplayer_ui(multiplayer_ui* ui);
 
 #endif
@@ -1,4 +1,5 @@
 #include "raylib.h"
+#include <math.h>
 #include <stdlib.h>
 #include <string.h>
 #include <SDL2/SDL_image.h>
@@ -13,12 +14,85 @@ static bool* mouse_pressed = nullptr;
 static int screen_width = 0;
 static int screen_height = 0;
 static int target_fps = 60;
-static TTF_Font* default_font = nullptr;
 static unsigned int rprand_state = 0;
 static SDL_Cursor* cursor_normal = nullptr;
 static SDL_Cursor* cursor_pointer = nullptr;
 static int last_char_pressed = 0;
 
+// Printable ASCII is rasterized once per font size into an atlas texture
+#define FONT_CACHE_CAPACITY 8
+#define FONT_FIRST_GLYPH 32
+#define FONT_LAST_GLYPH 126
+#define FONT_GLYPH_COUNT (FONT_LAST_GLYPH - FONT_FIRST_GLYPH + 1)
+#define FONT_ATLAS_WIDTH 1024
+
+typedef struct {
+    SDL_Rect source;
+    int advance;
+} glyph_info;
+
+typedef struct {
+    int size;
+    TTF_Font* font;
+    SDL_Texture* atlas;
+    int atlas_height;
+    glyph_info glyphs[FONT_GLYPH_COUNT];
+    unsigned int last_used;
+} font_entry;
+
+static font_entry font_cache[FONT_CACHE_CAPACITY];
+static int font_cache_count = 0;
+static unsigned int font_cache_clock = 0;
+static unsigned int font_cache_generation = 0;
+static SDL_Vertex* text_vertices = nullptr;
+static int* text_indices = nullptr;
+static size_t text_glyph_capacity = 0;
+
+static void unload_font_cache(void);
+
+// Labels keep quads in screen space against a glyph atlas; font_generation
+// catches the atlas being evicted underneath them
+struct label_geometry {
+    SDL_Vertex* vertices;
+    int* indices;
+    int quad_count;
+    int quad_capacity;
+    unsigned int font_generation;
+    int x;
+    int y;
+    color tint;
+};
+
+// Inside begin_sprite_batch/end_sprite_batch, textured quads are collected
+// per texture and drawn with one SDL_RenderGeometry call each. Any other
+// drawing flushes the batch first so it still lands on top.
+#define SPRITE_BATCH_TEXTURES 16
+
+typedef struct {
+    SDL_Texture* texture;
+    float texture_width;
+    float texture_height;
+    SDL_Vertex* vertices;
+    int* indices;
+    size_t quad_count;
+    size_t quad_capacity;
+} sprite_bucket;
+
+static sprite_bucket sprite_buckets[SPRITE_BATCH_TEXTURES];
+static int sprite_bucket_count = 0;
+static bool sprite_batching = false;
+
+static void flush_sprite_batch(void);
+static void unload_sprite_batch(void);
+
+#define ATLAS_PAGE_SIZE 2048
+#define ATLAS_MAX_PAGES 2
+#define ATLAS_MAX_IMAGES 32
+#define ATLAS_PADDING 1
+static bool viewport_set = false;
+static SDL_Rect viewport_rect = {0, 0, 0, 0};
+static int render_target_resets = 0;
+
 void init_window(const int width, const int height, const char* const title) {
     if (SDL_Init(SDL_INIT_VIDEO) < 0) {
         fprintf(stderr, "ERROR: SDL_Init failed: %s\n", SDL_GetError());
@@ -79,13 +153,17 @@ void set_window_size(const int width, const int height) {
 
 void set_viewport(const int x, const int y, const int width, const int height) {
     if (renderer) {
-        const SDL_Rect viewport = {x, y, width, height};
-        SDL_RenderSetViewport(renderer, &viewport);
+        flush_sprite_batch();
+        viewport_rect = (SDL_Rect){x, y, width, height};
+        viewport_set = true;
+        SDL_RenderSetViewport(renderer, &viewport_rect);
     }
 }
 
 void reset_viewport(void) {
     if (renderer) {
+        flush_sprite_batch();
+        viewport_set = false;
         SDL_RenderSetViewport(renderer, nullptr);
     }
 }
@@ -97,7 +175,8 @@ void set_target_fps(const int fps) {
 void close_window(void) {
     if (cursor_normal) SDL_FreeCursor(cursor_normal);
     if (cursor_pointer) SDL_FreeCursor(cursor_pointer);
-    if (default_font) TTF_CloseFont(default_font);
+    unload_font_cache();
+    unload_sprite_batch();
     free(keys_pressed);
     free(mouse_pressed);
     if (renderer) SDL_DestroyRenderer(renderer);
@@ -120,6 +199,9 @@ bool window_should_close(void) {
         if (event.type == SDL_KEYDOWN) {
             keys_pressed[event.key.keysym.scancode] = true;
         }
+        if (event.type == SDL_RENDER_TARGETS_RESET || event.type == SDL_RENDER_DEVICE_RESET) {
+            render_target_resets++;
+        }
         if (event.type == SDL_TEXTINPUT) {
             // Use SDL's text input event which handles shift, numpad, etc.
             // Only capture single character input
@@ -154,10 +236,12 @@ void begin_drawing(void) {
 }
 
 void end_drawing(void) {
+    flush_sprite_batch();
     SDL_RenderPresent(renderer);
 }
 
 void clear_background(const color c) {
+    flush_sprite_batch();
     SDL_SetRenderDrawColor(renderer, c.r, c.g, c.b, c.a);
     SDL_RenderClear(renderer);
 }
@@ -178,11 +262,15 @@ float get_frame_time(void) {
     return delta_time;
 }
 
+double get_time(void) {
+    return (double)SDL_GetPerformanceCounter() / (double)SDL_GetPerformanceFrequency();
+}
+
 texture_2d load_texture(const char* const file_name) {
     SDL_Surface* const surface = IMG_Load(file_name);
     if (!surface) {
         fprintf(stderr, "ERROR: Failed to load texture %s: %s\n", file_name, IMG_GetError());
-        return (texture_2d){0, 0, 0};
+        return (texture_2d){0};
     }
 
     SDL_Texture* const texture = SDL_CreateTextureFromSurface(renderer, surface);
@@ -192,12 +280,183 @@ texture_2d load_texture(const char* const file_name) {
 
     if (!texture) {
         fprintf(stderr, "ERROR: Failed to create texture %s: %s\n", file_name, SDL_GetError());
-        return (texture_2d){0, 0, 0};
+        return (texture_2d){0};
     }
 
     SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND);
 
-    return (texture_2d){(uintptr_t)texture, width, height};
+    return (texture_2d){.id = (uintptr_t)texture, .width = width, .height = height};
+}
+
+texture_2d load_render_texture(const int width, const int height) {
+    SDL_Texture* const texture = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_TARGET, width, height);
+    if (!texture) {
+        fprintf(stderr, "ERROR: Failed to create render texture: %s\n", SDL_GetError());
+        return (texture_2d){0};
+    }
+
+    SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND);
+
+    return (texture_2d){.id = (uintptr_t)texture, .width = width, .height = height};
+}
+
+// Redirects drawing into target, cleared to transparent, until end_texture_mode
+bool begin_texture_mode(const texture_2d target) {
+    if (target.id == 0) {
+        return false;
+    }
+
+    flush_sprite_batch();
+    if (SDL_SetRenderTarget(renderer, (SDL_Texture*)(uintptr_t)target.id) < 0) {
+        fprintf(stderr, "ERROR: SDL_SetRenderTarget failed: %s\n", SDL_GetError());
+        return false;
+    }
+
+    SDL_SetRenderDrawColor(renderer, 0, 0, 0, 0);
+    SDL_RenderClear(renderer);
+    return true;
+}
+
+// Switching targets resets the viewport, so a split screen one is put back
+void end_texture_mode(void) {
+    flush_sprite_batch();
+    SDL_SetRenderTarget(renderer, nullptr);
+    SDL_RenderSetViewport(renderer, viewport_set ? &viewport_rect : nullptr);
+}
+
+// Render texture contents are lost when this changes
+int get_render_target_resets(void) {
+    return render_target_resets;
+}
+
+// Shelf packs the images tallest first into as few pages as the renderer's
+// texture size allows, so sprites drawn together share one texture
+bool load_texture_atlas(const char* const* const file_names, const int count, texture_2d* const out_textures) {
+    if (count <= 0 || count > ATLAS_MAX_IMAGES) {
+        fprintf(stderr, "ERROR: Texture atlas needs 1 to %d images, got %d\n", ATLAS_MAX_IMAGES, count);
+        return false;
+    }
+
+    SDL_RendererInfo info = {0};
+    int page_size = ATLAS_PAGE_SIZE;
+    if (SDL_GetRendererInfo(renderer, &info) == 0 && info.max_texture_width > 0 && info.max_texture_height > 0) {
+        const int max_size = info.max_texture_width < info.max_texture_height ? info.max_texture_width : info.max_texture_height;
+        page_size = page_size < max_size ? page_size : max_size;
+    }
+
+    SDL_Surface* images[ATLAS_MAX_IMAGES] = {nullptr};
+    int order[ATLAS_MAX_IMAGES];
+    int page_of[ATLAS_MAX_IMAGES];
+    int page_heights[ATLAS_MAX_PAGES] = {0};
+    SDL_Texture* pages[ATLAS_MAX_PAGES] = {nullptr};
+    bool loaded = true;
+
+    for (int i = 0; i < count && loaded; i++) {
+        SDL_Surface* const surface = IMG_Load(file_names[i]);
+        if (!surface) {
+            fprintf(stderr, "ERROR: Failed to load texture %s: %s\n", file_names[i], IMG_GetError());
+            loaded = false;
+            break;
+        }
+        images[i] = SDL_ConvertSurfaceFormat(surface, SDL_PIXELFORMAT_RGBA32, 0);
+        SDL_FreeSurface(surface);
+        loaded = images[i] != nullptr && images[i]->w <= page_size && images[i]->h <= page_size;
+        if (!loaded) {
+            fprintf(stderr, "ERROR: Cannot pack %s into a %d pixel atlas page\n", file_names[i], page_size);
+        }
+        order[i] = i;
+    }
+
+    // Insertion sort by height, tallest first, keeps shelves tight
+    for (int i = 1; i < count && loaded; i++) {
+        const int current = order[i];
+        int j = i - 1;
+        while (j >= 0 && images[order[j]]->h < images[current]->h) {
+            order[j + 1] = order[j];
+            j--;
+        }
+        order[j + 1] = current;
+    }
+
+    int page = 0;
+    int shelf_x = 0;
+    int shelf_y = 0;
+    int shelf_height = 0;
+    for (int i = 0; i < count && loaded; i++) {
+        const SDL_Surface* const image = images[order[i]];
+
+        if (shelf_x + image->w > page_size) {
+            shelf_x = 0;
+            shelf_y += shelf_height + ATLAS_PADDING;
+            shelf_height = 0;
+        }
+        if (shelf_y + image->h > page_size) {
+            if (++page == ATLAS_MAX_PAGES) {
+                fprintf(stderr, "ERROR: Texture atlas needs more than %d pages\n", ATLAS_MAX_PAGES);
+                loaded = false;
+                break;
+            }
+            shelf_x = 0;
+            shelf_y = 0;
+            shelf_height = 0;
+        }
+
+        out_textures[order[i]] = (texture_2d){.width = image->w, .height = image->h, .x = shelf_x, .y = shelf_y};
+        page_of[order[i]] = page;
+        if (image->h > shelf_height) shelf_height = image->h;
+        if (shelf_y + image->h > page_heights[page]) page_heights[page] = shelf_y + image->h;
+        shelf_x += image->w + ATLAS_PADDING;
+    }
+
+    for (int p = 0; p <= page && loaded; p++) {
+        SDL_Surface* const sheet = SDL_CreateRGBSurfaceWithFormat(0, page_size, page_heights[p], 32, SDL_PIXELFORMAT_RGBA32);
+        if (!sheet) {
+            loaded = false;
+            break;
+        }
+        SDL_FillRect(sheet, nullptr, 0);
+
+        for (int i = 0; i < count; i++) {
+            if (page_of[i] != p) continue;
+            SDL_Rect dest = {out_textures[i].x, out_textures[i].y, out_textures[i].width, out_textures[i].height};
+            SDL_SetSurfaceBlendMode(images[i], SDL_BLENDMODE_NONE);
+            SDL_BlitSurface(images[i], nullptr, sheet, &dest);
+        }
+
+        pages[p] = SDL_CreateTextureFromSurface(renderer, sheet);
+        SDL_FreeSurface(sheet);
+        if (!pages[p]) {
+            fprintf(stderr, "ERROR: Failed to create atlas page: %s\n", SDL_GetError());
+            loaded = false;
+            break;
+        }
+        SDL_SetTextureBlendMode(pages[p], SDL_BLENDMODE_BLEND);
+    }
+
+    for (int i = 0; i < count; i++) {
+        if (images[i]) SDL_FreeSurface(images[i]);
+        out_textures[i].id = loaded ? (uintptr_t)pages[page_of[i]] : 0;
+    }
+
+    if (!loaded) {
+        for (int p = 0; p < ATLAS_MAX_PAGES; p++) {
+            if (pages[p]) SDL_DestroyTexture(pages[p]);
+        }
+    }
+    return loaded;
+}
+
+// Atlas regions share pages, so each page is destroyed once
+void unload_texture_atlas(const texture_2d* const textures, const int count) {
+    for (int i = 0; i < count; i++) {
+        bool seen = false;
+        for (int j = 0; j < i && !seen; j++) {
+            seen = textures[j].id == textures[i].id;
+        }
+        if (!seen) {
+            unload_texture(textures[i]);
+        }
+    }
 }
 
 void unload_texture(const texture_2d texture) {
@@ -206,11 +465,147 @@ void unload_texture(const texture_2d texture) {
     }
 }
 
+static void flush_sprite_batch(void) {
+    for (int i = 0; i < sprite_bucket_count; i++) {
+        sprite_bucket* const bucket = &sprite_buckets[i];
+        if (bucket->quad_count == 0) continue;
+
+        if (SDL_RenderGeometry(renderer, bucket->texture, bucket->vertices, (int)bucket->quad_count * 4,
+                               bucket->indices, (int)bucket->quad_count * 6) < 0) {
+            fprintf(stderr, "ERROR: SDL_RenderGeometry failed: %s\n", SDL_GetError());
+        }
+        bucket->quad_count = 0;
+    }
+    sprite_bucket_count = 0;
+}
+
+static void unload_sprite_batch(void) {
+    for (int i = 0; i < SPRITE_BATCH_TEXTURES; i++) {
+        free(sprite_buckets[i].vertices);
+        free(sprite_buckets[i].indices);
+        sprite_buckets[i] = (sprite_bucket){0};
+    }
+    sprite_bucket_count = 0;
+}
+
+void begin_sprite_batch(void) {
+    sprite_batching = true;
+}
+
+void end_sprite_batch(void) {
+    flush_sprite_batch();
+    sprite_batching = false;
+}
+
+// Buckets keep their buffers between frames; only the texture is reassigned
+static sprite_bucket* get_sprite_bucket(SDL_Texture* const texture) {
+    for (int i = 0; i < sprite_bucket_count; i++) {
+        if (sprite_buckets[i].texture == texture) {
+            return &sprite_buckets[i];
+        }
+    }
+
+    if (sprite_bucket_count == SPRITE_BATCH_TEXTURES) {
+        flush_sprite_batch();
+    }
+
+    sprite_bucket* const bucket = &sprite_buckets[sprite_bucket_count++];
+    int width = 1;
+    int height = 1;
+    SDL_QueryTexture(texture, nullptr, nullptr, &width, &height);
+
+    bucket->texture = texture;
+    bucket->texture_width = (float)(width > 0 ? width : 1);
+    bucket->texture_height = (float)(height > 0 ? height : 1);
+    bucket->quad_count = 0;
+    return bucket;
+}
+
+static bool reserve_sprite_quads(sprite_bucket* const bucket) {
+    if (bucket->quad_count < bucket->quad_capacity) {
+        return true;
+    }
+
+    const size_t capacity = bucket->quad_capacity == 0 ? 256 : bucket->quad_capacity * 2;
+
+    SDL_Vertex* const vertices = realloc(bucket->vertices, sizeof(SDL_Vertex) * 4 * capacity);
+    if (!vertices) return false;
+    bucket->vertices = vertices;
+
+    int* const indices = realloc(bucket->indices, sizeof(int) * 6 * capacity);
+    if (!indices) return false;
+    bucket->indices = indices;
+
+    for (size_t quad = bucket->quad_capacity; quad < capacity; quad++) {
+        const int base = (int)quad * 4;
+        int* const index = &bucket->indices[quad * 6];
+        index[0] = base;
+        index[1] = base + 1;
+        index[2] = base + 2;
+        index[3] = base;
+        index[4] = base + 2;
+        index[5] = base + 3;
+    }
+
+    bucket->quad_capacity = capacity;
+    return true;
+}
+
+// Same placement as SDL_RenderCopyEx: the quad is rotated about dest.x/dest.y,
+// which is where origin lands, with the rotation baked into the corners
+static void batch_texture_quad(const texture_2d texture, const rectangle source, const rectangle dest,
+                               const vector2 origin, const float rotation, const color c) {
+    sprite_bucket* const bucket = get_sprite_bucket((SDL_Texture*)(uintptr_t)texture.id);
+    if (!reserve_sprite_quads(bucket)) {
+        fprintf(stderr, "ERROR: Failed to grow sprite batch\n");
+        return;
+    }
+
+    const float corner_x[4] = {-origin.x, dest.width - origin.x, dest.width - origin.x, -origin.x};
+    const float corner_y[4] = {-origin.y, -origin.y, dest.height - origin.y, dest.height - origin.y};
+
+    const float left = (float)texture.x + source.x;
+    const float top = (float)texture.y + source.y;
+    const float u0 = left / bucket->texture_width;
+    const float v0 = top / bucket->texture_height;
+    const float u1 = (left + source.width) / bucket->texture_width;
+    const float v1 = (top + source.height) / bucket->texture_height;
+    const float corner_u[4] = {u0, u1, u1, u0};
+    const float corner_v[4] = {v0, v0, v1, v1};
+
+    float cos_r = 1.0f;
+    float sin_r = 0.0f;
+    if (fabsf(rotation) > 0.0f) {
+        const float radians = rotation * (3.14159265f / 180.0f);
+        cos_r = cosf(radians);
+        sin_r = sinf(radians);
+    }
+
+    const SDL_Color vertex_color = {c.r, c.g, c.b, c.a};
+    SDL_Vertex* const v = &bucket->vertices[bucket->quad_count * 4];
+
+    for (int i = 0; i < 4; i++) {
+        v[i] = (SDL_Vertex){
+            {dest.x + corner_x[i] * cos_r - corner_y[i] * sin_r, dest.y + corner_x[i] * sin_r + corner_y[i] * cos_r},
+            vertex_color,
+            {corner_u[i], corner_v[i]}
+        };
+    }
+    bucket->quad_count++;
+}
+
 void draw_texture_pro(const texture_2d texture, const rectangle source, const rectangle dest, const vector2 origin, const float rotation, const color c) {
     if (texture.id == 0) {
         return;
     }
 
+    if (sprite_batching) {
+        batch_texture_quad(texture, source, dest, origin, rotation, c);
+        return;
+    }
+
+    flush_sprite_batch();
+
     const auto sdl_texture = (SDL_Texture*)(uintptr_t)texture.id;
 
     if (SDL_SetTextureColorMod(sdl_texture, c.r, c.g, c.b) < 0) {
@@ -224,8 +619,8 @@ void draw_texture_pro(const texture_2d texture, const rectangle source, const re
     }
 
     const SDL_Rect src_rect = {
-        (int)source.x,
-        (int)source.y,
+        texture.x + (int)source.x,
+        texture.y + (int)source.y,
         (int)source.width,
         (int)source.height
     };
@@ -245,73 +640,383 @@ void draw_texture_pro(const texture_2d texture, const rectangle source, const re
 }
 
 void draw_rectangle(const int pos_x, const int pos_y, const int width, const int height, const color c) {
+    flush_sprite_batch();
     SDL_SetRenderDrawColor(renderer, c.r, c.g, c.b, c.a);
     const SDL_Rect rect = {pos_x, pos_y, width, height};
     SDL_RenderFillRect(renderer, &rect);
 }
 
 void draw_rectangle_lines(const int pos_x, const int pos_y, const int width, const int height, const color c) {
+    flush_sprite_batch();
     SDL_SetRenderDrawColor(renderer, c.r, c.g, c.b, c.a);
     const SDL_Rect rect = {pos_x, pos_y, width, height};
     SDL_RenderDrawRect(renderer, &rect);
 }
 
-void draw_text(const char* const text, const int pos_x, const int pos_y, const int font_size, const color c) {
-    if (!text || text[0] == '\0') return;  // Skip null or empty strings
+static bool build_glyph_atlas(font_entry* const entry) {
+    constexpr SDL_Color glyph_color = {255, 255, 255, 255};
+    SDL_Surface* glyph_surfaces[FONT_GLYPH_COUNT] = {nullptr};
+
+    const int row_height = TTF_FontHeight(entry->font);
+    int pen_x = 0;
+    int pen_y = 0;
+
+    for (int i = 0; i < FONT_GLYPH_COUNT; i++) {
+        const Uint16 ch = (Uint16)(FONT_FIRST_GLYPH + i);
+        glyph_info* const glyph = &entry->glyphs[i];
 
-    if (!default_font || TTF_FontHeight(default_font) != font_size) {
-        if (default_font) TTF_CloseFont(default_font);
-        default_font = TTF_OpenFont("/usr/share/fonts/TTF/DejaVuSans.ttf", font_size);
-        if (!default_font) {
-            default_font = TTF_OpenFont("/usr/share/fonts/truetype/dejavu/DejaVuSans.ttf", font_size);
+        int advance = 0;
+        TTF_GlyphMetrics(entry->font, ch, nullptr, nullptr, nullptr, nullptr, &advance);
+        glyph->advance = advance;
+
+        glyph_surfaces[i] = TTF_RenderGlyph_Blended(entry->font, ch, glyph_color);
+        if (!glyph_surfaces[i]) {
+            glyph->source = (SDL_Rect){0, 0, 0, 0};
+            continue;
         }
-        if (!default_font) {
-            fprintf(stderr, "ERROR: Failed to load font: %s\n", TTF_GetError());
-            return;
+
+        if (pen_x + glyph_surfaces[i]->w > FONT_ATLAS_WIDTH) {
+            pen_x = 0;
+            pen_y += row_height;
         }
+        glyph->source = (SDL_Rect){pen_x, pen_y, glyph_surfaces[i]->w, glyph_surfaces[i]->h};
+        pen_x += glyph_surfaces[i]->w + 1;
     }
 
-    const SDL_Color sdl_color = {c.r, c.g, c.b, c.a};
-    SDL_Surface* const surface = TTF_RenderText_Blended(default_font, text, sdl_color);
-    if (!surface) {
-        fprintf(stderr, "ERROR: Failed to render text: %s\n", TTF_GetError());
-        return;
+    SDL_Surface* const atlas = SDL_CreateRGBSurfaceWithFormat(0, FONT_ATLAS_WIDTH, pen_y + row_height, 32, SDL_PIXELFORMAT_RGBA32);
+    bool built = atlas != nullptr;
+
+    for (int i = 0; i < FONT_GLYPH_COUNT; i++) {
+        if (!glyph_surfaces[i]) continue;
+
+        if (built) {
+            SDL_Rect dest = entry->glyphs[i].source;
+            SDL_SetSurfaceBlendMode(glyph_surfaces[i], SDL_BLENDMODE_NONE);
+            SDL_BlitSurface(glyph_surfaces[i], nullptr, atlas, &dest);
+        }
+        SDL_FreeSurface(glyph_surfaces[i]);
     }
 
-    SDL_Texture* const texture = SDL_CreateTextureFromSurface(renderer, surface);
-    const int width = surface->w;
-    const int height = surface->h;
-    SDL_FreeSurface(surface);
+    if (built) {
+        entry->atlas_height = atlas->h;
+        entry->atlas = SDL_CreateTextureFromSurface(renderer, atlas);
+        built = entry->atlas != nullptr;
+        SDL_FreeSurface(atlas);
+    }
 
-    if (!texture) {
-        fprintf(stderr, "ERROR: Failed to create text texture: %s\n", SDL_GetError());
+    if (!built) {
+        fprintf(stderr, "ERROR: Failed to build glyph atlas: %s\n", SDL_GetError());
+        return false;
+    }
+
+    SDL_SetTextureBlendMode(entry->atlas, SDL_BLENDMODE_BLEND);
+    return true;
+}
+
+static void unload_font_entry(font_entry* const entry) {
+    if (entry->atlas) {
+        SDL_DestroyTexture(entry->atlas);
+        font_cache_generation++;
+    }
+    if (entry->font) TTF_CloseFont(entry->font);
+    *entry = (font_entry){0};
+}
+
+static void unload_font_cache(void) {
+    for (int i = 0; i < font_cache_count; i++) {
+        unload_font_entry(&font_cache[i]);
+    }
+    font_cache_count = 0;
+
+    free(text_vertices);
+    free(text_indices);
+    text_vertices = nullptr;
+    text_indices = nullptr;
+    text_glyph_capacity = 0;
+}
+
+// Opened fonts and their atlases stay cached by size; once the cache is full
+// the least recently used size is dropped
+static font_entry* get_font(const int font_size) {
+    font_cache_clock++;
+
+    for (int i = 0; i < font_cache_count; i++) {
+        if (font_cache[i].size == font_size) {
+            font_cache[i].last_used = font_cache_clock;
+            return font_cache[i].atlas ? &font_cache[i] : nullptr;
+        }
+    }
+
+    font_entry* entry;
+    if (font_cache_count < FONT_CACHE_CAPACITY) {
+        entry = &font_cache[font_cache_count++];
+    } else {
+        entry = &font_cache[0];
+        for (int i = 1; i < FONT_CACHE_CAPACITY; i++) {
+            if (font_cache[i].last_used < entry->last_used) {
+                entry = &font_cache[i];
+            }
+        }
+        unload_font_entry(entry);
+    }
+
+    // A size that fails to load stays cached without an atlas so it is not retried every frame
+    entry->size = font_size;
+    entry->last_used = font_cache_clock;
+    entry->font = TTF_OpenFont("/usr/share/fonts/TTF/DejaVuSans.ttf", font_size);
+    if (!entry->font) {
+        entry->font = TTF_OpenFont("/usr/share/fonts/truetype/dejavu/DejaVuSans.ttf", font_size);
+    }
+    if (!entry->font) {
+        fprintf(stderr, "ERROR: Failed to load font: %s\n", TTF_GetError());
+        return nullptr;
+    }
+
+    return build_glyph_atlas(entry) ? entry : nullptr;
+}
+
+static int glyph_slot(const char ch) {
+    const int code = (unsigned char)ch;
+    if (code < FONT_FIRST_GLYPH || code > FONT_LAST_GLYPH) {
+        return '?' - FONT_FIRST_GLYPH;
+    }
+    return code - FONT_FIRST_GLYPH;
+}
+
+static int glyph_kerning(const font_entry* const entry, const int previous, const int slot) {
+    if (previous < 0) return 0;
+    return TTF_GetFontKerningSizeGlyphs(entry->font, (Uint16)(previous + FONT_FIRST_GLYPH), (Uint16)(slot + FONT_FIRST_GLYPH));
+}
+
+static bool reserve_text_quads(const size_t glyph_count) {
+    if (glyph_count <= text_glyph_capacity) {
+        return true;
+    }
+
+    size_t capacity = text_glyph_capacity == 0 ? 64 : text_glyph_capacity;
+    while (capacity < glyph_count) {
+        capacity *= 2;
+    }
+
+    SDL_Vertex* const vertices = realloc(text_vertices, sizeof(SDL_Vertex) * 4 * capacity);
+    if (!vertices) return false;
+    text_vertices = vertices;
+
+    int* const indices = realloc(text_indices, sizeof(int) * 6 * capacity);
+    if (!indices) return false;
+    text_indices = indices;
+
+    text_glyph_capacity = capacity;
+    return true;
+}
+
+// Lays out one quad per visible glyph and returns how many were written
+static int build_text_quads(const font_entry* const entry, const char* const text, const size_t length,
+                            const int pos_x, const int pos_y, const color c,
+                            SDL_Vertex* const vertices, int* const indices) {
+    const SDL_Color vertex_color = {c.r, c.g, c.b, c.a};
+    const float atlas_width = (float)FONT_ATLAS_WIDTH;
+    const float atlas_height = (float)entry->atlas_height;
+
+    int pen_x = pos_x;
+    int previous = -1;
+    int quads = 0;
+
+    for (size_t i = 0; i < length; i++) {
+        const int slot = glyph_slot(text[i]);
+        const glyph_info* const glyph = &entry->glyphs[slot];
+
+        pen_x += glyph_kerning(entry, previous, slot);
+        previous = slot;
+
+        if (glyph->source.w > 0) {
+            const float x0 = (float)pen_x;
+            const float y0 = (float)pos_y;
+            const float x1 = x0 + (float)glyph->source.w;
+            const float y1 = y0 + (float)glyph->source.h;
+            const float u0 = (float)glyph->source.x / atlas_width;
+            const float v0 = (float)glyph->source.y / atlas_height;
+            const float u1 = (float)(glyph->source.x + glyph->source.w) / atlas_width;
+            const float v1 = (float)(glyph->source.y + glyph->source.h) / atlas_height;
+
+            SDL_Vertex* const v = &vertices[quads * 4];
+            v[0] = (SDL_Vertex){{x0, y0}, vertex_color, {u0, v0}};
+            v[1] = (SDL_Vertex){{x1, y0}, vertex_color, {u1, v0}};
+            v[2] = (SDL_Vertex){{x1, y1}, vertex_color, {u1, v1}};
+            v[3] = (SDL_Vertex){{x0, y1}, vertex_color, {u0, v1}};
+
+            int* const index = &indices[quads * 6];
+            const int base = quads * 4;
+            index[0] = base;
+            index[1] = base + 1;
+            index[2] = base + 2;
+            index[3] = base;
+            index[4] = base + 2;
+            index[5] = base + 3;
+            quads++;
+        }
+
+        pen_x += glyph->advance;
+    }
+
+    return quads;
+}
+
+// The whole string is one geometry call against the size's glyph atlas
+void draw_text(const char* const text, const int pos_x, const int pos_y, const int font_size, const color c) {
+    if (!text || text[0] == '\0') return;  // Skip null or empty strings
+
+    const font_entry* const entry = get_font(font_size);
+    if (!entry) {
         return;
     }
+    flush_sprite_batch();
 
-    const SDL_Rect dest = {pos_x, pos_y, width, height};
-    SDL_RenderCopy(renderer, texture, nullptr, &dest);
-    SDL_DestroyTexture(texture);
+    const size_t length = strlen(text);
+    if (!reserve_text_quads(length)) {
+        fprintf(stderr, "ERROR: Failed to allocate text vertices\n");
+        return;
+    }
+
+    const int quads = build_text_quads(entry, text, length, pos_x, pos_y, c, text_vertices, text_indices);
+    if (quads > 0 && SDL_RenderGeometry(renderer, entry->atlas, text_vertices, quads * 4, text_indices, quads * 6) < 0) {
+        fprintf(stderr, "ERROR: SDL_RenderGeometry failed: %s\n", SDL_GetError());
+    }
 }
 
 int measure_text(const char* const text, const int font_size) {
     if (!text || text[0] == '\0') return 0;  // Skip null or empty strings
 
-    if (!default_font || TTF_FontHeight(default_font) != font_size) {
-        if (default_font) TTF_CloseFont(default_font);
-        default_font = TTF_OpenFont("/usr/share/fonts/TTF/DejaVuSans.ttf", font_size);
-        if (!default_font) {
-            default_font = TTF_OpenFont("/usr/share/fonts/truetype/dejavu/DejaVuSans.ttf", font_size);
-        }
-        if (!default_font) {
-            return (int)strlen(text) * (font_size / 2);
-        }
+    const font_entry* const entry = get_font(font_size);
+    if (!entry) {
+        return (int)strlen(text) * (font_size / 2);
     }
 
     int width = 0;
-    TTF_SizeText(default_font, text, &width, nullptr);
+    int previous = -1;
+    for (const char* ch = text; *ch != '\0'; ch++) {
+        const int slot = glyph_slot(*ch);
+        width += glyph_kerning(entry, previous, slot) + entry->glyphs[slot].advance;
+        previous = slot;
+    }
     return width;
 }
 
+// Returns true, and binds the value, when it differs from the one last bound,
+// so callers format a label's text only when it would change
+bool label_value_changed(text_label* const label, const int64_t value) {
+    if (!label || (label->bound && label->value == value)) {
+        return false;
+    }
+    label->value = value;
+    label->bound = true;
+    return true;
+}
+
+void set_label_text(text_label* const label, const char* const text, const int font_size) {
+    if (!label || !text) return;
+
+    constexpr size_t max_length = TEXT_LABEL_CAPACITY - 1;
+    if (label->font_size == font_size && strncmp(label->text, text, max_length) == 0) {
+        return;
+    }
+
+    size_t length = strlen(text);
+    length = length < max_length ? length : max_length;
+    memcpy(label->text, text, length);
+    label->text[length] = '\0';
+    label->font_size = font_size;
+    label->width = measure_text(label->text, font_size);
+    label->dirty = true;
+}
+
+static bool rebuild_label(text_label* const label, const font_entry* const entry,
+                          const int pos_x, const int pos_y, const color c) {
+    label_geometry* const geometry = label->geometry;
+    const size_t length = strlen(label->text);
+
+    if ((int)length > geometry->quad_capacity) {
+        SDL_Vertex* const vertices = realloc(geometry->vertices, sizeof(SDL_Vertex) * 4 * length);
+        if (!vertices) return false;
+        geometry->vertices = vertices;
+
+        int* const indices = realloc(geometry->indices, sizeof(int) * 6 * length);
+        if (!indices) return false;
+        geometry->indices = indices;
+
+        geometry->quad_capacity = (int)length;
+    }
+
+    geometry->quad_count = build_text_quads(entry, label->text, length, pos_x, pos_y, c,
+                                            geometry->vertices, geometry->indices);
+    geometry->font_generation = font_cache_generation;
+    geometry->x = pos_x;
+    geometry->y = pos_y;
+    geometry->tint = c;
+    label->dirty = false;
+    return true;
+}
+
+static bool same_color(const color a, const color b) {
+    return a.r == b.r && a.g == b.g && a.b == b.b && a.a == b.a;
+}
+
+// Steady state is one geometry call with no formatting, measuring or layout
+void draw_label(text_label* const label, const int pos_x, const int pos_y, const color c) {
+    if (!label || label->text[0] == '\0') return;
+
+    const font_entry* const entry = get_font(label->font_size);
+    if (!entry) {
+        return;
+    }
+    flush_sprite_batch();
+
+    if (!label->geometry) {
+        label->geometry = calloc(1, sizeof(label_geometry));
+        if (!label->geometry) {
+            fprintf(stderr, "ERROR: Failed to allocate label geometry\n");
+            return;
+        }
+        label->dirty = true;
+    }
+
+    label_geometry* const geometry = label->geometry;
+    const bool stale = label->dirty || geometry->font_generation != font_cache_generation ||
+                       !same_color(geometry->tint, c);
+    if (stale && !rebuild_label(label, entry, pos_x, pos_y, c)) {
+        fprintf(stderr, "ERROR: Failed to allocate label vertices\n");
+        return;
+    }
+
+    // A moved label, such as a tooltip following the mouse, keeps its layout
+    if (geometry->x != pos_x || geometry->y != pos_y) {
+        const float dx = (float)(pos_x - geometry->x);
+        const float dy = (float)(pos_y - geometry->y);
+        for (int i = 0; i < geometry->quad_count * 4; i++) {
+            geometry->vertices[i].position.x += dx;
+            geometry->vertices[i].position.y += dy;
+        }
+        geometry->x = pos_x;
+        geometry->y = pos_y;
+    }
+
+    if (geometry->quad_count > 0 &&
+        SDL_RenderGeometry(renderer, entry->atlas, geometry->vertices, geometry->quad_count * 4,
+                           geometry->indices, geometry->quad_count * 6) < 0) {
+        fprintf(stderr, "ERROR: SDL_RenderGeometry failed: %s\n", SDL_GetError());
+    }
+}
+
+void unload_label(text_label* const label) {
+    if (!label || !label->geometry) return;
+
+    free(label->geometry->vertices);
+    free(label->geometry->indices);
+    free(label->geometry);
+    label->geometry = nullptr;
+    label->dirty = true;
+}
+
 void draw_fps(const int pos_x, const int pos_y) {
     const int fps = (int)(1.0f / delta_time);
     char fps_text[32];
@@ -5,30 +5,7 @@
 #include <stdint.h>
 #include <stdio.h>
 
-typedef struct vector2 {
-    float x;
-    float y;
-} vector2;
-
-typedef struct rectangle {
-    float x;
-    float y;
-    float width;
-    float height;
-} rectangle;
-
-typedef struct color {
-    unsigned char r;
-    unsigned char g;
-    unsigned char b;
-    unsigned char a;
-} color;
-
-typedef struct texture_2d {
-    uintptr_t id;
-    int width;
-    int height;
-} texture_2d;
+#include "raylib_types.h"
 
 constexpr color white = {255, 255, 255, 255};
 constexpr color black = {0, 0, 0, 255};
@@ -39,6 +16,8 @@ constexpr color gold = {255, 215, 0, 255};
 constexpr color lightgray = {200, 200, 200, 255};
 
 static constexpr int key_space = SDLK_SPACE;
+static constexpr int key_e = SDLK_e;
+static constexpr int key_f = SDLK_f;
 static constexpr int mouse_button_left = SDL_BUTTON_LEFT;
 static constexpr int mouse_button_right = SDL_BUTTON_RIGHT;
 
@@ -55,14 +34,27 @@ void clear_background(color c);
 int get_screen_width(void);
 int get_screen_height(void);
 float get_frame_time(void);
+double get_time(void);
 
 texture_2d load_texture(const char* file_name);
 void unload_texture(texture_2d texture);
+bool load_texture_atlas(const char* const* file_names, int count, texture_2d* out_textures);
+void unload_texture_atlas(const texture_2d* textures, int count);
+texture_2d load_render_texture(int width, int height);
+bool begin_texture_mode(texture_2d target);
+void end_texture_mode(void);
+int get_render_target_resets(void);
 void draw_texture_pro(texture_2d texture, rectangle source, rectangle dest, vector2 origin, float rotation, color c);
+void begin_sprite_batch(void);
+void end_sprite_batch(void);
 void draw_rectangle(int pos_x, int pos_y, int width, int height, color c);
 void draw_rectangle_lines(int pos_x, int pos_y, int width, int height, color c);
 void draw_text(const char* text, int pos_x, int pos_y, int font_size, color c);
 int measure_text(const char* text, int font_size);
+bool label_value_changed(text_label* label, int64_t value);
+void set_label_text(text_label* label, const char* text, int font_size);
+void draw_label(text_label* label, int pos_x, int pos_y, color c);
+void unload_label(text_label* label);
 void draw_fps(int pos_x, int pos_y);
 
 bool is_key_pressed(int key);
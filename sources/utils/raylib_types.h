@@ -0,0 +1,54 @@
+#ifndef RAYLIB_TYPES_H
+#define RAYLIB_TYPES_H
+
+#include <stdint.h>
+
+// Plain value types shared with the simulation, which must build without SDL
+
+typedef struct vector2 {
+    float x;
+    float y;
+} vector2;
+
+typedef struct rectangle {
+    float x;
+    float y;
+    float width;
+    float height;
+} rectangle;
+
+typedef struct color {
+    unsigned char r;
+    unsigned char g;
+    unsigned char b;
+    unsigned char a;
+} color;
+
+// x and y place the image inside its texture; they are non-zero for images
+// packed into an atlas page, where width and height are the image's own size
+typedef struct texture_2d {
+    uintptr_t id;
+    int width;
+    int height;
+    int x;
+    int y;
+} texture_2d;
+
+#define TEXT_LABEL_CAPACITY 128
+
+typedef struct label_geometry label_geometry;
+
+// Retained text: the glyph quads of the last draw are kept in geometry and
+// rebuilt only when the text, size or color changes. value is the
+// caller's bound value, see label_value_changed.
+typedef struct text_label {
+    char text[TEXT_LABEL_CAPACITY];
+    int font_size;
+    int width;
+    int64_t value;
+    bool bound;
+    bool dirty;
+    label_geometry* geometry;
+} text_label;
+
+#endif // RAYLIB_TYPES_H